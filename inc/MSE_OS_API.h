@@ -15,16 +15,56 @@
 #include "MSE_OS_Core.h"
 
 /*==================[macros and definitions]=================================*/
-#define OS_QUEUE_HEAP_SIZE		256
 #define OS_QUEUE_DEFAULT_VALUE 0xFF
 
+#define OS_QUEUESET_MAX_MEMBERS	32
+
+/** Prioridades de los mensajes de una cola con prioridad (0 es la mayor) */
+#define OS_QUEUE_PRIORITY_HIGHEST	0
+#define OS_QUEUE_PRIORITY_LOWEST	0xFF
+
+struct os_QueueSet;
+
 typedef struct
+{
+	uint32_t period; /** activation period in ticks */
+	uint32_t lastRelease; /** tick of the last ideal activation */
+	uint32_t activations; /** activations served */
+	uint32_t overruns; /** activations skipped because the task was late */
+	uint32_t minJitterUs; /** smallest delay between ideal and actual wake up */
+	uint32_t maxJitterUs; /** largest delay between ideal and actual wake up */
+	uint64_t sumJitterUs; /** accumulated delay, for the average */
+} os_Periodic_t;
+
+typedef struct os_Semaphore
 {
 	os_TaskHandler_t * takenByTask;
 	bool	taken;
+	os_TaskHandler_t * owner; /** task holding the semaphore, or NULL */
+	struct os_QueueSet * set; /** set the semaphore belongs to, or NULL */
+	uint8_t setIndex; /** member index inside the set */
+	struct os_Semaphore * nextRegistered; /** next semaphore in the registry of initialized semaphores */
 } os_Semaphore_t;
 
+/** Lock de lectura/escritura: varios lectores o un único escritor a la vez */
+typedef struct os_RwLock
+{
+	uint16_t readers; /** tasks currently holding the lock for reading */
+	os_TaskHandler_t * writer; /** task holding the lock for writing, or NULL */
+	bool writerPreference; /** new readers wait while a writer is waiting */
+	os_TaskHandler_t * readersWaiting; /** blocked readers, highest priority first */
+	os_TaskHandler_t * writersWaiting; /** blocked writers, highest priority first */
+	struct os_RwLock * nextRegistered; /** next lock in the registry of initialized locks */
+} os_RwLock_t;
+
+/** Variable de condición: se usa junto a un semáforo que protege el estado
+ *  compartido, tomado como mutex */
 typedef struct
+{
+	os_TaskHandler_t * waiting; /** blocked tasks, highest priority first */
+} os_CondVar_t;
+
+typedef struct os_Queue
 {
 	uint16_t headID; /** queue header index */
 	uint16_t tailID; /** queue tail index */
@@ -33,8 +73,65 @@ typedef struct
 	uint16_t elementSize; /** element size in bytes */
 	uint8_t data[OS_QUEUE_HEAP_SIZE]; /** queue internal heap*/
 	os_TaskHandler_t * taskWaitingForIt; /** task waiting for element insertion in the queue */
+	struct os_QueueSet * set; /** set the queue belongs to, or NULL */
+	uint8_t setIndex; /** member index inside the set */
+	bool priorityMode; /** data holds a binary heap ordered by message priority */
+	uint32_t sequence; /** insertion counter, keeps FIFO order within a priority */
+	uint16_t peakSize; /** largest number of elements seen since the last reset */
+	uint32_t waitCount; /** times a task blocked on the queue (full or empty) */
+	struct os_Queue * nextRegistered; /** next queue in the registry of initialized queues */
 } os_Queue_t;
 
+typedef enum
+{
+	os_queueset_member__queue,
+	os_queueset_member__semaphore
+} os_QueueSetMemberType_t;
+
+typedef struct
+{
+	os_QueueSetMemberType_t type;
+	void * object;
+} os_QueueSetMember_t;
+
+/** Conjunto de colas y semáforos sobre el que una tarea puede esperar a la vez */
+typedef struct os_QueueSet
+{
+	os_QueueSetMember_t members[OS_QUEUESET_MAX_MEMBERS];
+	uint8_t numberOfMembers;
+	uint32_t pendingMask; /** members that may be ready, MSB = member 0 */
+	os_TaskHandler_t * taskWaiting; /** task blocked in os_queueset_select */
+} os_QueueSet_t;
+
+/** Cada mensaje de un message buffer se guarda precedido por su largo */
+typedef uint16_t os_messageLength_t;
+
+typedef struct
+{
+	uint16_t headID; /** write index */
+	uint16_t tailID; /** read index */
+	uint16_t usedBytes; /** bytes currently stored in the ring */
+	uint16_t triggerLevel; /** bytes needed to wake a blocked reader (stream mode) */
+	bool isMessageBuffer; /** true: length-prefixed records, false: byte stream */
+	uint8_t data[OS_STREAM_BUFFER_SIZE]; /** ring storage */
+	os_TaskHandler_t * readerWaiting; /** task waiting for data */
+	os_TaskHandler_t * writerWaiting; /** task waiting for free space */
+} os_StreamBuffer_t;
+
+#define OS_PINGPONG_NONE	0xFF
+
+/** Doble buffer: el productor (normalmente el DMA) llena un bloque mientras
+ *  la tarea procesa el otro. Los bloques se entregan por puntero */
+typedef struct
+{
+	void * blocks[2]; /** the two sample blocks */
+	uint8_t writeBlock; /** block being filled by the producer */
+	volatile uint8_t readyBlock; /** filled block not yet received, or OS_PINGPONG_NONE */
+	volatile uint8_t heldBlock; /** block owned by the task, or OS_PINGPONG_NONE */
+	volatile uint32_t overruns; /** blocks overwritten before being processed */
+	os_TaskHandler_t * readerWaiting; /** task waiting for a filled block */
+} os_PingPong_t;
+
 
 /*==================[public functions]=======================================*/
 
@@ -49,6 +146,49 @@ typedef struct
 ******************************************************************************/
 void os_Delay(uint32_t ticks);
 
+/******************************************************************************
+ *  @brief Espera hasta un instante absoluto.
+ *
+ *  @details
+ *   Permite ejecutar un lazo con período fijo, sin que el tiempo de
+ *   ejecución ni los desalojos alarguen el período. Antes de la primera
+ *   llamada, *previousWake debe inicializarse con os_get_systemClockMs().
+ *   Si el instante ya pasó, retorna sin bloquear.
+ *
+ *  @param *previousWake		instante de la activación anterior, se
+ *  							actualiza al de esta activación
+ *  @param period				período en ticks
+ *  @return     false si la tarea llegó tarde a la activación.
+******************************************************************************/
+bool os_DelayUntil(uint32_t * previousWake, uint32_t period);
+
+/******************************************************************************
+ *  @brief Inicialización de una activación periódica.
+ *
+ *  @details
+ *   La primera activación ocurre un período después de esta llamada.
+ *
+ *  @param *periodic			puntero a la activación periódica
+ *  @param period				período en ticks
+ *  @return     none.
+******************************************************************************/
+void os_periodic_init(os_Periodic_t * periodic, uint32_t period);
+
+/******************************************************************************
+ *  @brief Espera la próxima activación periódica.
+ *
+ *  @details
+ *   Las activaciones ocurren siempre en múltiplos exactos del período. Si la
+ *   tarea llegó tarde, las activaciones ya vencidas se cuentan como overruns
+ *   y se espera la siguiente, sin perder la fase. Al despertar se registra
+ *   el jitter: el retardo, en microsegundos, entre el instante ideal de la
+ *   activación y el momento en que la tarea vuelve a ejecutarse.
+ *
+ *  @param *periodic			puntero a la activación periódica
+ *  @return     cantidad de activaciones perdidas (0 si llegó a tiempo).
+******************************************************************************/
+uint32_t os_periodic_wait(os_Periodic_t * periodic);
+
 /******************************************************************************
  *  @brief Inicialización de un semáforo.
  *
@@ -86,6 +226,166 @@ void os_sem_take(os_Semaphore_t * sem);
 ******************************************************************************/
 void os_sem_give(os_Semaphore_t * sem);
 
+/******************************************************************************
+ *  @brief Liberación de los semáforos tomados por una tarea.
+ *
+ *  @details
+ *   La llama os_task_delete, para que los semáforos que tenía tomados la
+ *   tarea eliminada no queden tomados para siempre ni apuntando a su TCB.
+ *   Cada uno se da como si lo hiciera la propia tarea.
+ *
+ *  @param *task			tarea eliminada
+ *  @return     none.
+******************************************************************************/
+void os_sem_releaseTask(os_TaskHandler_t * task);
+
+/******************************************************************************
+ *  @brief Inicialización de un lock de lectura/escritura.
+ *
+ *  @details
+ *   Con preferencia de escritura, un lector nuevo espera mientras haya un
+ *   escritor esperando, de modo que los lectores no puedan postergar
+ *   indefinidamente a los escritores. Sin ella, los lectores solo esperan
+ *   mientras un escritor tiene el lock.
+ *
+ *  @param *lock				puntero al lock
+ *  @param writerPreference		true para dar preferencia a los escritores
+ *  @return     none.
+******************************************************************************/
+void os_rwlock_init(os_RwLock_t * lock, bool writerPreference);
+
+/******************************************************************************
+ *  @brief Tomar un lock de lectura/escritura para lectura.
+ *
+ *  @details
+ *   Varias tareas pueden tener el lock para lectura a la vez. Las tareas en
+ *   espera se despiertan por orden de prioridad. No debe usarse desde una
+ *   interrupción ni tomarse en forma anidada.
+ *
+ *  @param *lock				puntero al lock
+ *  @param timeout				ticks a esperar como máximo, OS_NO_WAIT u
+ *  							OS_WAIT_FOREVER
+ *  @return     true si se obtuvo el lock.
+******************************************************************************/
+bool os_rwlock_readLock(os_RwLock_t * lock, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Liberar un lock de lectura/escritura tomado para lectura.
+ *
+ *  @details
+ *   Al salir el último lector se despierta al escritor más prioritario que
+ *   esté esperando.
+ *
+ *  @param *lock				puntero al lock
+ *  @return     none.
+******************************************************************************/
+void os_rwlock_readUnlock(os_RwLock_t * lock);
+
+/******************************************************************************
+ *  @brief Tomar un lock de lectura/escritura para escritura.
+ *
+ *  @details
+ *   Solo una tarea puede tener el lock para escritura, y mientras la tenga
+ *   no hay lectores. No debe usarse desde una interrupción ni tomarse en
+ *   forma anidada.
+ *
+ *  @param *lock				puntero al lock
+ *  @param timeout				ticks a esperar como máximo, OS_NO_WAIT u
+ *  							OS_WAIT_FOREVER
+ *  @return     true si se obtuvo el lock.
+******************************************************************************/
+bool os_rwlock_writeLock(os_RwLock_t * lock, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Liberar un lock de lectura/escritura tomado para escritura.
+ *
+ *  @details
+ *   Se despierta al escritor más prioritario que esté esperando o a todos
+ *   los lectores, según la preferencia configurada.
+ *
+ *  @param *lock				puntero al lock
+ *  @return     none.
+******************************************************************************/
+void os_rwlock_writeUnlock(os_RwLock_t * lock);
+
+/******************************************************************************
+ *  @brief Liberación de los locks de lectura/escritura tomados por una tarea.
+ *
+ *  @details
+ *   La llama os_task_delete. Un lock tomado para escritura por la tarea
+ *   eliminada se libera y se despierta a las tareas que pueden tomarlo. Si
+ *   la tarea era el único escritor en espera, los lectores que esperaban
+ *   por preferencia de escritura también se despiertan. Las lecturas solo
+ *   se cuentan, no se registra qué tarea las tiene, por lo que un lock
+ *   tomado para lectura por la tarea eliminada no puede recuperarse: no
+ *   debe eliminarse una tarea mientras tenga un lock tomado para lectura.
+ *
+ *  @param *task			tarea eliminada
+ *  @return     none.
+******************************************************************************/
+void os_rwlock_releaseTask(os_TaskHandler_t * task);
+
+/******************************************************************************
+ *  @brief Inicialización de una variable de condición.
+ *
+ *  @param *cond				puntero a la variable de condición
+ *  @return     none.
+******************************************************************************/
+void os_cond_init(os_CondVar_t * cond);
+
+/******************************************************************************
+ *  @brief Esperar una variable de condición.
+ *
+ *  @details
+ *   La tarea debe haber tomado el semáforo con os_sem_take. El semáforo se
+ *   libera y la tarea se bloquea en un único paso, por lo que no puede
+ *   perderse una señal enviada entre ambos. Al despertar se vuelve a tomar
+ *   el semáforo antes de retornar. Como la tarea puede despertar sin que el
+ *   predicado se cumpla (otra tarea lo modificó antes, o fue suspendida y
+ *   reanudada), debe llamarse dentro de un lazo que lo verifique.
+ *   No debe usarse desde una interrupción.
+ *
+ *  @param *cond				puntero a la variable de condición
+ *  @param *mutex				semáforo tomado por la tarea
+ *  @return     none.
+******************************************************************************/
+void os_cond_wait(os_CondVar_t * cond, os_Semaphore_t * mutex);
+
+/******************************************************************************
+ *  @brief Esperar una variable de condición con timeout.
+ *
+ *  @details
+ *   Igual que os_cond_wait. Aun si el timeout expira, el semáforo se vuelve
+ *   a tomar antes de retornar. Con OS_NO_WAIT retorna sin liberarlo.
+ *
+ *  @param *cond				puntero a la variable de condición
+ *  @param *mutex				semáforo tomado por la tarea
+ *  @param timeout				ticks a esperar como máximo, u OS_WAIT_FOREVER
+ *  @return     false si expiró el timeout.
+******************************************************************************/
+bool os_cond_timedWait(os_CondVar_t * cond, os_Semaphore_t * mutex, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Despertar a una tarea que espera una variable de condición.
+ *
+ *  @details
+ *   Se despierta a la tarea en espera más prioritaria. Conviene llamarla
+ *   con el semáforo tomado, luego de modificar el estado compartido. Si no
+ *   hay tareas esperando, la señal se pierde.
+ *
+ *  @param *cond				puntero a la variable de condición
+ *  @return     none.
+******************************************************************************/
+void os_cond_signal(os_CondVar_t * cond);
+
+/******************************************************************************
+ *  @brief Despertar a todas las tareas que esperan una variable de condición.
+ *
+ *  @param *cond				puntero a la variable de condición
+ *  @return     none.
+******************************************************************************/
+void os_cond_broadcast(os_CondVar_t * cond);
+
 
 /******************************************************************************
  *  @brief Inicialización de una cola.
@@ -93,6 +393,8 @@ void os_sem_give(os_Semaphore_t * sem);
  *  @details
  *   El tamáño de los elementos de la cola se selecciona al momento de
  *   inicializar la cola. Las colas tienen asignados un heap estático.
+ *   Reinicializar una cola la vacía pero conserva el conjunto al que
+ *   pertenece.
  *
  *  @param *queue				puntero a la cola
  *  @param dataSize				tamaño en bytes que tendrá cada elemento
@@ -101,12 +403,43 @@ void os_sem_give(os_Semaphore_t * sem);
 ******************************************************************************/
 void os_queue_init(os_Queue_t * queue, uint16_t dataSize);
 
+/******************************************************************************
+ *  @brief Inicialización de una cola con prioridad.
+ *
+ *  @details
+ *   os_queue_remove devuelve siempre el mensaje de mayor prioridad, y entre
+ *   mensajes de igual prioridad el más antiguo. Los mensajes se ordenan en
+ *   un heap binario dentro del heap estático de la cola, por lo que insertar
+ *   y remover cuesta O(log n). Cada elemento ocupa 4 bytes más que en una
+ *   cola FIFO.
+ *
+ *  @param *queue				puntero a la cola
+ *  @param dataSize				tamaño en bytes que tendrá cada elemento
+ *  							de la cola
+ *  @return     none.
+******************************************************************************/
+void os_queue_initPriority(os_Queue_t * queue, uint16_t dataSize);
+
+/******************************************************************************
+ *  @brief Insersión de un elemento con prioridad a la cola.
+ *
+ *  @details
+ *   Igual que os_queue_insert. En una cola FIFO la prioridad se ignora.
+ *
+ *  @param *queue				puntero a la cola
+ *  @param *data				puntero al elemento que se insertará en la cola
+ *  @param priority				prioridad del elemento (0 es la mayor)
+ *  @return     none.
+******************************************************************************/
+void os_queue_insertPriority(os_Queue_t * queue, void * data, uint8_t priority);
+
 /******************************************************************************
  *  @brief Insersión de un elemento a la cola.
  *
  *  @details
  *   Si la cola no tiene espacio,la tarea que intenta insertar un elemento
- *   queda bloqueada hasta que otra tarea quite un elemento de la cola.
+ *   queda bloqueada hasta que otra tarea quite un elemento de la cola. En
+ *   una cola con prioridad el elemento tiene la menor prioridad.
  *
  *  @param *queue				puntero a la cola
  *  @param *data				puntero al elemento que se insertará en la cola
@@ -127,5 +460,234 @@ void os_queue_insert(os_Queue_t * queue, void * data);
 ******************************************************************************/
 void os_queue_remove(os_Queue_t * queue, void * data);
 
+/******************************************************************************
+ *  @brief Recorre las colas inicializadas.
+ *
+ *  @details
+ *   Cada cola queda registrada la primera vez que se inicializa, para que
+ *   las herramientas de diagnóstico puedan mostrar su ocupación.
+ *
+ *  @param *queue				cola anterior, o NULL para obtener la primera
+ *  @return     cola siguiente, NULL si no hay más.
+******************************************************************************/
+os_Queue_t * os_queue_getNext(os_Queue_t * queue);
+
+/******************************************************************************
+ *  @brief Reinicia las estadísticas de una cola.
+ *
+ *  @details
+ *   El pico de ocupación vuelve a la ocupación actual y se borra la cuenta
+ *   de esperas.
+ *
+ *  @param *queue				puntero a la cola
+ *  @return     none.
+******************************************************************************/
+void os_queue_resetStats(os_Queue_t * queue);
+
+
+/******************************************************************************
+ *  @brief Inicialización de un conjunto de colas y semáforos.
+ *
+ *  @param *set					puntero al conjunto
+ *  @return     none.
+******************************************************************************/
+void os_queueset_init(os_QueueSet_t * set);
+
+/******************************************************************************
+ *  @brief Agrega una cola a un conjunto.
+ *
+ *  @details
+ *   Una cola puede pertenecer a un solo conjunto, y solo la tarea que espera
+ *   en el conjunto debería leerla. Debe agregarse antes de usarla.
+ *
+ *  @param *set					puntero al conjunto
+ *  @param *queue				cola a agregar
+ *  @return     true si tuvo éxito.
+******************************************************************************/
+bool os_queueset_addQueue(os_QueueSet_t * set, os_Queue_t * queue);
+
+/******************************************************************************
+ *  @brief Agrega un semáforo a un conjunto.
+ *
+ *  @details
+ *   Un semáforo puede pertenecer a un solo conjunto. Debe agregarse antes
+ *   de usarlo.
+ *
+ *  @param *set					puntero al conjunto
+ *  @param *sem					semáforo a agregar
+ *  @return     true si tuvo éxito.
+******************************************************************************/
+bool os_queueset_addSemaphore(os_QueueSet_t * set, os_Semaphore_t * sem);
+
+/******************************************************************************
+ *  @brief Espera a que alguno de los objetos de un conjunto esté listo.
+ *
+ *  @details
+ *   Una cola está lista cuando tiene elementos y un semáforo cuando está
+ *   libre. Si hay varios listos se devuelve el primero que se agregó al
+ *   conjunto. Luego la tarea debe leer la cola (os_queue_remove) o tomar el
+ *   semáforo (os_sem_take), lo que no la bloquea. Desde una interrupción
+ *   nunca se bloquea.
+ *
+ *  @param *set					puntero al conjunto
+ *  @param timeout				ticks a esperar (OS_NO_WAIT, OS_WAIT_FOREVER)
+ *  @return     puntero a la cola o semáforo listo, NULL si expiró el timeout.
+******************************************************************************/
+void * os_queueset_select(os_QueueSet_t * set, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Inicialización de un stream buffer.
+ *
+ *  @details
+ *   Un stream buffer transporta un flujo de bytes sin delimitar. Tiene un
+ *   único lector y un único escritor.
+ *
+ *  @param *sb					puntero al stream buffer
+ *  @param triggerLevel			cantidad de bytes que deben estar disponibles
+ *  							para despertar a un lector bloqueado (mínimo 1)
+ *  @return     none.
+******************************************************************************/
+void os_stream_init(os_StreamBuffer_t * sb, uint16_t triggerLevel);
+
+/******************************************************************************
+ *  @brief Escritura en un stream buffer.
+ *
+ *  @details
+ *   Escribe todos los bytes que entren y, si faltan, espera a que se libere
+ *   espacio hasta que expire el timeout. Desde una interrupción nunca se
+ *   bloquea.
+ *
+ *  @param *sb					puntero al stream buffer
+ *  @param *data				bytes a escribir
+ *  @param length				cantidad de bytes a escribir
+ *  @param timeout				ticks a esperar (OS_NO_WAIT, OS_WAIT_FOREVER)
+ *  @return     cantidad de bytes escritos.
+******************************************************************************/
+uint16_t os_stream_send(os_StreamBuffer_t * sb, const void * data,
+		uint16_t length, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Lectura de un stream buffer.
+ *
+ *  @details
+ *   Espera hasta que haya al menos triggerLevel bytes o expire el timeout,
+ *   y luego lee todos los disponibles (hasta maxLength). Desde una
+ *   interrupción nunca se bloquea.
+ *
+ *  @param *sb					puntero al stream buffer
+ *  @param *data				destino de los bytes leídos
+ *  @param maxLength			cantidad máxima de bytes a leer
+ *  @param timeout				ticks a esperar (OS_NO_WAIT, OS_WAIT_FOREVER)
+ *  @return     cantidad de bytes leídos.
+******************************************************************************/
+uint16_t os_stream_receive(os_StreamBuffer_t * sb, void * data,
+		uint16_t maxLength, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Inicialización de un message buffer.
+ *
+ *  @details
+ *   Un message buffer transporta mensajes de largo variable. Cada mensaje
+ *   ocupa solo su largo más sizeof(os_messageLength_t) bytes del ring.
+ *
+ *  @param *sb					puntero al message buffer
+ *  @return     none.
+******************************************************************************/
+void os_message_init(os_StreamBuffer_t * sb);
+
+/******************************************************************************
+ *  @brief Envío de un mensaje.
+ *
+ *  @details
+ *   El mensaje se escribe completo o no se escribe. Si no hay espacio se
+ *   espera hasta que expire el timeout. Desde una interrupción nunca se
+ *   bloquea. Los mensajes de largo cero no se envían.
+ *
+ *  @param *sb					puntero al message buffer
+ *  @param *data				mensaje a enviar
+ *  @param length				largo del mensaje en bytes (mayor que cero)
+ *  @param timeout				ticks a esperar (OS_NO_WAIT, OS_WAIT_FOREVER)
+ *  @return     true si el mensaje fue enviado.
+******************************************************************************/
+bool os_message_send(os_StreamBuffer_t * sb, const void * data,
+		uint16_t length, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Recepción de un mensaje.
+ *
+ *  @details
+ *   Si el próximo mensaje no entra en maxLength queda en el buffer y se
+ *   devuelve cero, sin esperar. Para distinguir este caso de un timeout, y
+ *   conocer el tamaño de destino necesario, se usa os_message_nextLength.
+ *   Desde una interrupción nunca se bloquea.
+ *
+ *  @param *sb					puntero al message buffer
+ *  @param *data				destino del mensaje
+ *  @param maxLength			tamaño del destino en bytes
+ *  @param timeout				ticks a esperar (OS_NO_WAIT, OS_WAIT_FOREVER)
+ *  @return     largo del mensaje recibido, cero si no se recibió ninguno.
+******************************************************************************/
+uint16_t os_message_receive(os_StreamBuffer_t * sb, void * data,
+		uint16_t maxLength, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Largo del próximo mensaje.
+ *
+ *  @details
+ *   No retira el mensaje ni bloquea.
+ *
+ *  @param *sb					puntero al message buffer
+ *  @return     largo del próximo mensaje, cero si el buffer está vacío.
+******************************************************************************/
+uint16_t os_message_nextLength(os_StreamBuffer_t * sb);
+
+/******************************************************************************
+ *  @brief Inicialización de un doble buffer.
+ *
+ *  @details
+ *   El productor comienza llenando block0.
+ *
+ *  @param *pp					puntero al doble buffer
+ *  @param *block0				primer bloque
+ *  @param *block1				segundo bloque
+ *  @return     none.
+******************************************************************************/
+void os_pingpong_init(os_PingPong_t * pp, void * block0, void * block1);
+
+/******************************************************************************
+ *  @brief El productor terminó de llenar un bloque.
+ *
+ *  @details
+ *   Pensada para llamarse desde la interrupción de fin de bloque del DMA.
+ *   El bloque pasa a estar disponible para la tarea y el productor continúa
+ *   con el otro. Si la tarea todavía no había procesado ese otro bloque, se
+ *   cuenta un overrun: su contenido se pierde.
+ *
+ *  @param *pp					puntero al doble buffer
+ *  @return     bloque que el productor debe llenar a continuación.
+******************************************************************************/
+void * os_pingpong_blockFilled(os_PingPong_t * pp);
+
+/******************************************************************************
+ *  @brief Recepción de un bloque lleno.
+ *
+ *  @details
+ *   El bloque pertenece a la tarea hasta que llame a os_pingpong_release.
+ *   Desde una interrupción nunca se bloquea.
+ *
+ *  @param *pp					puntero al doble buffer
+ *  @param timeout				ticks a esperar (OS_NO_WAIT, OS_WAIT_FOREVER)
+ *  @return     puntero al bloque, NULL si expiró el timeout.
+******************************************************************************/
+void * os_pingpong_receive(os_PingPong_t * pp, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Devuelve al productor el bloque recibido.
+ *
+ *  @param *pp					puntero al doble buffer
+ *  @return     none.
+******************************************************************************/
+void os_pingpong_release(os_PingPong_t * pp);
+
 
 #endif /* INC_MSE_OS_API_H_ */
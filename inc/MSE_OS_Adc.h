@@ -0,0 +1,86 @@
+/*
+ * MSE_OS_Adc.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Adquisición continua del ADC por bloques mediante GPDMA
+ *
+ *  El ADC convierte en modo burst a la frecuencia indicada y el GPDMA copia
+ *  cada conversión a uno de los dos bloques de un doble buffer, sin
+ *  intervención del CPU. Solo se genera una interrupción por bloque, en la
+ *  que el bloque se entrega a la tarea por puntero (os_PingPong_t).
+ *
+ *  Ante un error del GPDMA el bloque incompleto no se entrega: se cuenta en
+ *  dmaErrors y la transferencia se reanuda desde el principio del mismo
+ *  bloque, por lo que la adquisición continúa.
+ */
+
+#ifndef INC_MSE_OS_ADC_H_
+#define INC_MSE_OS_ADC_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "board.h"
+#include "MSE_OS_API.h"
+
+/*==================[macros and definitions]=================================*/
+typedef enum
+{
+	os_adc_0,
+	os_adc_1,
+	os_adc_count
+} os_adc_id_t;
+
+typedef struct
+{
+	os_PingPong_t pingPong;
+	os_adc_id_t id;
+	uint8_t dmaChannel;
+	DMA_TransferDescriptor_t descriptors[2];
+	uint32_t blocks[2][OS_ADC_BLOCK_SAMPLES];	/** registros de datos leídos por el DMA */
+	volatile uint32_t dmaErrors;	/** bloques descartados por un error del GPDMA */
+} os_AdcStream_t;
+
+/*==================[public functions]=======================================*/
+
+/******************************************************************************
+ *  @brief Arranque de la adquisición continua.
+ *
+ *  @param *stream				estructura de la adquisición
+ *  @param id					ADC a utilizar
+ *  @param channel				canal del ADC
+ *  @param sampleRate			frecuencia de muestreo en Hz
+ *  @return     true si tuvo éxito.
+******************************************************************************/
+bool os_adc_startStream(os_AdcStream_t * stream, os_adc_id_t id,
+		ADC_CHANNEL_T channel, uint32_t sampleRate);
+
+/******************************************************************************
+ *  @brief Recepción de un bloque de muestras.
+ *
+ *  @details
+ *   Bloquea a la tarea hasta que el DMA complete un bloque. Las lecturas
+ *   se convierten a q15 en el mismo bloque, listas para las rutinas de
+ *   MSE_OS_DSP.h.
+ *
+ *  @param *stream				adquisición
+ *  @param timeout				ticks a esperar (OS_NO_WAIT, OS_WAIT_FOREVER)
+ *  @return     OS_ADC_BLOCK_SAMPLES muestras q15, NULL si expiró el timeout.
+******************************************************************************/
+int16_t * os_adc_receiveBlock(os_AdcStream_t * stream, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Devuelve al DMA el bloque recibido.
+ *
+ *  @details
+ *   El bloque debe procesarse antes de que el DMA complete el otro; de lo
+ *   contrario se cuenta un overrun en stream->pingPong.overruns.
+ *
+ *  @param *stream				adquisición
+ *  @return     none.
+******************************************************************************/
+void os_adc_releaseBlock(os_AdcStream_t * stream);
+
+#endif /* INC_MSE_OS_ADC_H_ */
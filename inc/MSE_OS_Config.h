@@ -0,0 +1,256 @@
+/*
+ * MSE_OS_Config.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Configuración del sistema operativo en tiempo de compilación.
+ *         Todas las estructuras del kernel se dimensionan exactamente
+ *         a partir de estos valores. Cualquiera de ellos puede
+ *         redefinirse desde la línea de compilación (-D).
+ */
+
+#ifndef INC_MSE_OS_CONFIG_H_
+#define INC_MSE_OS_CONFIG_H_
+
+/*==================[macros and definitions]=================================*/
+
+/************************************************************************************
+ * 	Tareas y prioridades
+ ***********************************************************************************/
+
+/** Valor numérico de la menor prioridad (0 es la mayor). Hasta 31 se usa un
+ *  bitmap de un nivel y hasta 254 uno de dos niveles (el valor siguiente
+ *  queda reservado para la tarea idle) */
+#ifndef OS_CONFIG_MAX_PRIORITY
+#define OS_CONFIG_MAX_PRIORITY		3
+#endif
+
+/** Cantidad máxima de tareas de usuario (sin contar la tarea idle) */
+#ifndef OS_CONFIG_MAX_TASKS
+#define OS_CONFIG_MAX_TASKS			8
+#endif
+
+/** Tamaño del stack de cada tarea expresado en bytes */
+#ifndef OS_CONFIG_STACK_SIZE
+#define OS_CONFIG_STACK_SIZE		256
+#endif
+
+/************************************************************************************
+ * 	Ubicación en memoria de TCBs y stacks
+ *
+ * 	Opcionalmente los TCB (y/o los stacks) pueden ubicarse en una sección
+ * 	particular, por ejemplo en el banco de SRAM local más rápido del LPC4337:
+ * 	#define OS_CONFIG_TCB_SECTION		".bss.$RamLoc32"
+ * 	#define OS_CONFIG_STACK_SECTION		".bss.$RamLoc40"
+ * 	Si no se definen, quedan en .bss junto al resto de los datos.
+ *
+ * 	Del mismo modo, las rutinas que se ejecutan en cada tick, en cada cambio de
+ * 	contexto y en cada interrupción pueden ubicarse en SRAM en lugar de
+ * 	ejecutarse desde la flash, y la estructura de control del kernel en el
+ * 	banco local.
+ *
+ * 	El código debe quedar en una sección que el linker script ubique en SRAM
+ * 	con dirección de carga en flash, y que el startup copie antes de main (en
+ * 	particular antes de la primera interrupción de SysTick). En la compilación
+ * 	con el Makefile de la CIAA, el linker script incluye *(.data*) en .data
+ * 	(RamLoc32, cargada desde la flash) y el startup copia .data al arrancar,
+ * 	por lo que alcanza con un nombre de sección que empiece con .data; el
+ * 	linker agrega los veneers para las llamadas entre flash y SRAM:
+ * 	#define OS_CONFIG_RAMFUNC_SECTION	".data.ramfunc"
+ * 	#define OS_CONFIG_CONTROL_SECTION	".bss.$RamLoc32"
+ * 	Un nombre que el linker script no reconozca (por ejemplo
+ * 	".ramfunc.$RamLoc40", propio de los linker scripts administrados por
+ * 	MCUXpresso) queda como sección huérfana y no se copia.
+ *
+ * 	Con OS_CONFIG_PROFILE_CYCLES el kernel mide con el contador de ciclos del
+ * 	DWT el costo de cada tick y de cada decisión de scheduling tomada en PendSV
+ * 	(os_getKernelCycles). No hay mediciones registradas de la ganancia de
+ * 	ejecutar desde SRAM: deben tomarse en la placa con y sin
+ * 	OS_CONFIG_RAMFUNC_SECTION.
+ ***********************************************************************************/
+
+/************************************************************************************
+ * 	Time slicing (round robin entre tareas de igual prioridad)
+ *
+ * 	El quantum se expresa en ticks. Una tarea solo pierde el CPU frente a otra de
+ * 	su misma prioridad cuando agota su quantum, se bloquea o llama a os_CpuYield.
+ * 	Con OS_TIME_SLICE_COOPERATIVE el quantum es infinito.
+ *
+ * 	Para configurar un quantum distinto por prioridad, definir
+ * 	OS_TIME_SLICE_TICKS_BY_PRIORITY con un valor por cada prioridad, por ejemplo:
+ * 	#define OS_TIME_SLICE_TICKS_BY_PRIORITY	{1, 5, 10, OS_TIME_SLICE_COOPERATIVE}
+ * 	Las prioridades que no figuren en la tabla quedan cooperativas.
+ ***********************************************************************************/
+#define OS_TIME_SLICE_COOPERATIVE	0
+
+#ifndef OS_TIME_SLICE_DEFAULT_TICKS
+#define OS_TIME_SLICE_DEFAULT_TICKS	10
+#endif
+
+/************************************************************************************
+ * 	Earliest deadline first (EDF)
+ *
+ * 	Opcionalmente una de las prioridades puede planificarse por EDF en lugar de
+ * 	round robin: entre las tareas listas de esa prioridad se ejecuta la de
+ * 	deadline absoluto más próximo. Las prioridades mayores siguen desalojando a
+ * 	las tareas EDF y las menores solo se ejecutan cuando no hay ninguna lista:
+ * 	#define OS_CONFIG_EDF_PRIORITY		2
+ * 	Si no se define, todas las prioridades usan round robin.
+ ***********************************************************************************/
+
+/************************************************************************************
+ * 	Colas
+ ***********************************************************************************/
+
+/** Heap estático de cada cola expresado en bytes */
+#ifndef OS_QUEUE_HEAP_SIZE
+#define OS_QUEUE_HEAP_SIZE			256
+#endif
+
+/************************************************************************************
+ * 	Comunicación entre núcleos (M4 <-> M0APP)
+ ***********************************************************************************/
+
+/** Dirección de la memoria compartida entre ambos núcleos. Ambas imágenes deben
+ *  compilarse con el mismo valor. Por defecto se usa el banco de 16 KB de la
+ *  SRAM AHB que comparte el ETB, libre si no se usa trazado */
+#ifndef OS_CONFIG_IPC_SHARED_ADDRESS
+#define OS_CONFIG_IPC_SHARED_ADDRESS	0x2000C000
+#endif
+
+/** Cantidad de mensajes de cada ring de la memoria compartida (potencia de 2) */
+#ifndef OS_CONFIG_IPC_RING_SIZE
+#define OS_CONFIG_IPC_RING_SIZE		16
+#endif
+
+/** Cantidad máxima de tareas del scheduler mínimo del M0APP */
+#ifndef OS_CONFIG_M0_MAX_TASKS
+#define OS_CONFIG_M0_MAX_TASKS		8
+#endif
+
+/************************************************************************************
+ * 	Stream y message buffers
+ ***********************************************************************************/
+
+/** Tamaño del ring de cada stream/message buffer expresado en bytes */
+#ifndef OS_STREAM_BUFFER_SIZE
+#define OS_STREAM_BUFFER_SIZE		256
+#endif
+
+/************************************************************************************
+ * 	Bus publicador/suscriptor
+ ***********************************************************************************/
+
+/** Cantidad de mensajes del pool compartido por todos los tópicos */
+#ifndef OS_PUBSUB_POOL_SIZE
+#define OS_PUBSUB_POOL_SIZE			8
+#endif
+
+/** Tamaño máximo de un mensaje expresado en bytes */
+#ifndef OS_PUBSUB_MESSAGE_SIZE
+#define OS_PUBSUB_MESSAGE_SIZE		16
+#endif
+
+/************************************************************************************
+ * 	Handlers run-to-completion
+ ***********************************************************************************/
+
+/** Cantidad de prioridades (un handler por prioridad) */
+#ifndef OS_CONFIG_SST_PRIORITIES
+#define OS_CONFIG_SST_PRIORITIES	8
+#endif
+
+/** Cantidad de eventos de la cola de cada handler (potencia de 2) */
+#ifndef OS_CONFIG_SST_QUEUE_SIZE
+#define OS_CONFIG_SST_QUEUE_SIZE	4
+#endif
+
+/************************************************************************************
+ * 	Log binario diferido
+ ***********************************************************************************/
+
+/** Tamaño del buffer de log expresado en palabras de 32 bits (potencia de 2) */
+#ifndef OS_CONFIG_LOG_BUFFER_WORDS
+#define OS_CONFIG_LOG_BUFFER_WORDS	256
+#endif
+
+/************************************************************************************
+ * 	Drivers
+ ***********************************************************************************/
+
+/** Timer de hardware (0 a 3) utilizado por las esperas de alta resolución */
+#ifndef OS_CONFIG_HR_TIMER
+#define OS_CONFIG_HR_TIMER			3
+#endif
+
+/** Tamaño del buffer circular de recepción de cada UART expresado en bytes. El
+ *  GPDMA lo recorre en dos mitades, cada una de hasta 4095 bytes */
+#ifndef OS_UART_RX_BUFFER_SIZE
+#define OS_UART_RX_BUFFER_SIZE		256
+#endif
+
+/** Cantidad de muestras de cada bloque de la adquisición continua del ADC */
+#ifndef OS_ADC_BLOCK_SAMPLES
+#define OS_ADC_BLOCK_SAMPLES		128
+#endif
+
+/*==================[checks]=================================================*/
+
+#if (OS_CONFIG_MAX_PRIORITY > 254)
+#error "OS_CONFIG_MAX_PRIORITY debe ser menor o igual a 254"
+#endif
+
+#if defined(OS_CONFIG_EDF_PRIORITY) && (OS_CONFIG_EDF_PRIORITY > OS_CONFIG_MAX_PRIORITY)
+#error "OS_CONFIG_EDF_PRIORITY debe ser menor o igual a OS_CONFIG_MAX_PRIORITY"
+#endif
+
+#if (OS_CONFIG_MAX_TASKS < 1) || (OS_CONFIG_MAX_TASKS > 65534)
+#error "OS_CONFIG_MAX_TASKS debe estar entre 1 y 65534"
+#endif
+
+#if (OS_CONFIG_IPC_RING_SIZE & (OS_CONFIG_IPC_RING_SIZE - 1))
+#error "OS_CONFIG_IPC_RING_SIZE debe ser potencia de 2"
+#endif
+
+#if (OS_CONFIG_LOG_BUFFER_WORDS & (OS_CONFIG_LOG_BUFFER_WORDS - 1))
+#error "OS_CONFIG_LOG_BUFFER_WORDS debe ser potencia de 2"
+#endif
+
+#if (OS_CONFIG_SST_PRIORITIES > 32)
+#error "OS_CONFIG_SST_PRIORITIES debe ser menor o igual a 32"
+#endif
+
+#if (OS_CONFIG_SST_QUEUE_SIZE & (OS_CONFIG_SST_QUEUE_SIZE - 1)) || (OS_CONFIG_SST_QUEUE_SIZE > 128)
+#error "OS_CONFIG_SST_QUEUE_SIZE debe ser potencia de 2 y menor o igual a 128"
+#endif
+
+#if (OS_CONFIG_M0_MAX_TASKS > 32)
+#error "OS_CONFIG_M0_MAX_TASKS debe ser menor o igual a 32"
+#endif
+
+#if (OS_STREAM_BUFFER_SIZE > 0xFFFF)
+#error "OS_STREAM_BUFFER_SIZE debe ser menor a 65536"
+#endif
+
+#if (OS_UART_RX_BUFFER_SIZE % 2) || (OS_UART_RX_BUFFER_SIZE > 8190)
+#error "OS_UART_RX_BUFFER_SIZE debe ser par y menor o igual a 8190"
+#endif
+
+#if (OS_ADC_BLOCK_SAMPLES % 4) || (OS_ADC_BLOCK_SAMPLES > 4092)
+#error "OS_ADC_BLOCK_SAMPLES debe ser múltiplo de 4 y menor a 4095"
+#endif
+
+#if (OS_PUBSUB_POOL_SIZE > 255)
+#error "OS_PUBSUB_POOL_SIZE debe ser menor a 256"
+#endif
+
+#if (OS_CONFIG_HR_TIMER > 3)
+#error "OS_CONFIG_HR_TIMER debe estar entre 0 y 3"
+#endif
+
+#if (OS_CONFIG_STACK_SIZE % 8)
+#error "OS_CONFIG_STACK_SIZE debe ser múltiplo de 8 (alineación AAPCS)"
+#endif
+
+#endif /* INC_MSE_OS_CONFIG_H_ */
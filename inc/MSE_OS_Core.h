@@ -16,14 +16,40 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "board.h"
+#include "MSE_OS_Config.h"
 
 /*==================[macros and definitions]=================================*/
 
-#define STACK_SIZE 256 /** Tamaño del stack predefinido para cada tarea expresado en bytes */
+#define STACK_SIZE OS_CONFIG_STACK_SIZE /** Tamaño del stack predefinido para cada tarea expresado en bytes */
 
-#define OS_IDLE_TASK_ID	0xFF
+#define OS_CONTROL_MAX_PRIORITY	OS_CONFIG_MAX_PRIORITY
 
-#define OS_CONTROL_MAX_PRIORITY	3
+#define OS_PRIORITY_LEVELS		(OS_CONTROL_MAX_PRIORITY + 1)
+
+/** Tipo utilizado para identificar y contar tareas, según OS_CONFIG_MAX_TASKS */
+#if (OS_CONFIG_MAX_TASKS < 255)
+typedef uint8_t os_taskId_t;
+#else
+typedef uint16_t os_taskId_t;
+#endif
+
+#define OS_IDLE_TASK_ID	((os_taskId_t)~0)
+
+/** Patrón con el que se pinta el stack de cada tarea al crearla */
+#define OS_STACK_PAINT_PATTERN	0xA5A5A5A5
+
+/** Rutinas del kernel que se ejecutan desde SRAM si OS_CONFIG_RAMFUNC_SECTION
+ *  está definida (ver MSE_OS_Config.h). noinline evita que se copien dentro
+ *  de rutinas en flash */
+#ifdef OS_CONFIG_RAMFUNC_SECTION
+#define OS_RAMFUNC	__attribute__((section(OS_CONFIG_RAMFUNC_SECTION), noinline))
+#else
+#define OS_RAMFUNC
+#endif
+
+/** Timeouts de las esperas, expresados en ticks */
+#define OS_NO_WAIT			0
+#define OS_WAIT_FOREVER		0xFFFFFFFF
 
 typedef enum
 {
@@ -32,7 +58,9 @@ typedef enum
 	os_control_error_no_task_added,
 	os_control_error_task_with_invalid_state,
 	os_control_error_task_max_priority_exceeded,
-	os_control_error_daly_from_IRQ
+	os_control_error_daly_from_IRQ,
+	os_control_error_edf_priority_reserved,
+	os_control_error_scheduler_locked
 } os_control_error_t;
 
 typedef enum
@@ -49,19 +77,54 @@ typedef enum
 	os_task_state__running,
 	os_task_state__ready,
 	os_task_state__blocked,
-	os_task_state__suspended
+	os_task_state__suspended,
+	os_task_state__deleted
 
 } os_TaskState_t;
 
+#ifdef OS_CONFIG_PROFILE_CYCLES
+/** Ciclos de CPU del tick (SysTick_Handler) y de la parte en C de PendSV
+ *  (os_scheduleFromPendSV, la decisión diferida desde interrupciones). El
+ *  intercambio de stacks en assembler tiene costo fijo y no se mide */
 typedef struct
 {
-	uint32_t stack[STACK_SIZE/4];
+	uint32_t tickLast;
+	uint32_t tickMax;
+	uint32_t switchLast;
+	uint32_t switchMax;
+} os_kernelCycles_t;
+#endif
+
+/**
+ * Los TCB pertenecen al kernel y se ubican contiguos en un pool. Los campos que
+ * leen el scheduler y el tick se agrupan al comienzo para que recorrer las tareas
+ * acceda a pocas posiciones de memoria consecutivas. El stack de cada tarea se
+ * encuentra en otro pool y el TCB solo guarda un puntero a él.
+ */
+typedef struct os_TaskHandler
+{
 	uint32_t stackPointer;
-	void *entryPoint;
+	struct os_TaskHandler * nextInPriority;	/** lista circular de tareas de igual prioridad */
+	uint32_t blockedTicks;
+	uint32_t sliceTicks;	/** ticks restantes del quantum de la tarea */
 	os_TaskState_t state;
 	uint8_t priority;
-	uint8_t taskID;
-	uint32_t blockedTicks;
+	os_taskId_t taskID;
+#ifdef OS_CONFIG_EDF_PRIORITY
+	uint32_t deadline;		/** deadline absoluto del trabajo actual, en ticks */
+	os_taskId_t edfIndex;	/** posición de la tarea en el heap de tareas EDF listas */
+#endif
+
+	/* Campos de uso poco frecuente */
+	uint32_t *stack;
+	void *entryPoint;
+	uint32_t runTicks;		/** ticks en los que la tarea estaba en ejecución */
+	struct os_TaskHandler ** waitSlot;	/** campo o enlace del objeto que apunta a la tarea */
+	struct os_TaskHandler * nextWaiting;	/** siguiente tarea de la lista de espera */
+#ifdef OS_CONFIG_EDF_PRIORITY
+	uint32_t relativeDeadline;	/** deadline de cada trabajo relativo a su liberación */
+	uint32_t deadlineMisses;	/** trabajos que terminaron luego de su deadline */
+#endif
 } os_TaskHandler_t;
 
 
@@ -120,18 +183,97 @@ extern uint32_t sp_tarea3;					//Stack Pointer para la tarea 3
  *
  *  @details
  *   Esta rutina inicializa la estructura de datos de la tarea y asociará
- *   un handler que se ejecutará cuando la tarea le toque ejecutarse
+ *   un handler que se ejecutará cuando la tarea le toque ejecutarse. El
+ *   TCB y el stack se toman de los pools del kernel, reutilizando los de
+ *   tareas eliminadas. Puede llamarse antes de os_Init o desde una tarea;
+ *   si la nueva tarea es más prioritaria que la actual, se ejecuta
+ *   inmediatamente.
+ *   La prioridad OS_CONFIG_EDF_PRIORITY, si está definida, queda reservada
+ *   para las tareas creadas con os_InitTaskEDF.
  *
- *  @param *taskHandler		puntero a la estructura de datos de la tarea
  *  @param *entryPoint		puntero a la rutina que se ejecutará cuando
  *  						deba ejecutarse esta tarea
- *  @param priority			prioridad de la tarea (valor entre 0 y 3, donde 0
- *  						0 es la mayor prioridad)
+ *  @param priority			prioridad de la tarea (valor entre 0 y
+ *  						OS_CONFIG_MAX_PRIORITY, donde 0 es la mayor prioridad)
+ *  @return     puntero a la estructura de datos de la tarea, NULL si falló.
+ *****************************************************************************/
+os_TaskHandler_t* os_InitTask(void* entryPoint, uint8_t priority);
+
+#ifdef OS_CONFIG_EDF_PRIORITY
+/******************************************************************************
+ *  @brief Inicialización de una tarea planificada por EDF
+ *
+ *  @details
+ *   La tarea se crea con la prioridad OS_CONFIG_EDF_PRIORITY. Cada vez que
+ *   pasa de bloqueada a ready comienza un nuevo trabajo, cuyo deadline
+ *   absoluto es el instante de liberación más relativeDeadline. Por eso la
+ *   tarea solo debería bloquearse al terminar cada trabajo (por ejemplo,
+ *   en el os_Delay o la espera de evento que marca su período). Si al
+ *   bloquearse ya pasó su deadline, se cuenta un deadline perdido.
+ *
+ *  @param *entryPoint		puntero a la rutina de la tarea
+ *  @param relativeDeadline	deadline de cada trabajo en ticks, a partir de
+ *  						su liberación
+ *  @return     puntero a la estructura de datos de la tarea, NULL si falló.
+ *****************************************************************************/
+os_TaskHandler_t* os_InitTaskEDF(void* entryPoint, uint32_t relativeDeadline);
+
+/******************************************************************************
+ *  @brief Obtiene la cantidad de deadlines perdidos de una tarea EDF
+ *
+ *  @param *task		puntero a la tarea
+ *  @return     trabajos que terminaron luego de su deadline.
+ *****************************************************************************/
+uint32_t os_getDeadlineMisses(os_TaskHandler_t * task);
+#endif
+
+/******************************************************************************
+ *  @brief Eliminación de una tarea
+ *
+ *  @details
+ *   Puede llamarse antes o después de os_Init, también desde una
+ *   interrupción. La tarea deja de figurar en el scheduler y en el objeto
+ *   por el que estuviera esperando, y su TCB y su stack vuelven al pool
+ *   para ser reutilizados por la próxima tarea creada. Si una tarea se
+ *   elimina a sí misma, la liberación se hace en el cambio de contexto,
+ *   cuando ya no utiliza su stack. Los semáforos y los locks de escritura
+ *   que tenga tomados se liberan en su nombre y, si estaba en
+ *   os_timer_sleepUntilUs, su nodo de espera se quita de la lista del
+ *   timer. Los locks tomados para lectura no pueden recuperarse
+ *   (os_rwlock_releaseTask).
+ *
+ *   La tarea actual no puede eliminarse con el scheduler bloqueado
+ *   (os_lock_scheduler), ya que seguiría ejecutándose: se registra el error
+ *   os_control_error_scheduler_locked y la tarea no se elimina.
+ *
+ *  @param *task		tarea a eliminar, o NULL para la tarea actual
+ *  @return     none.
+ *****************************************************************************/
+void os_task_delete(os_TaskHandler_t * task);
+
+/******************************************************************************
+ *  @brief Suspensión de una tarea
+ *
+ *  @details
+ *   La tarea no vuelve a ejecutarse hasta llamar a os_task_resume. Si
+ *   estaba esperando un objeto deja de figurar en él; al reanudarse vuelve
+ *   a evaluar la condición por la que esperaba. Los ticks de una espera
+ *   temporal no transcurren mientras está suspendida. Como en
+ *   os_task_delete, la tarea actual no puede suspenderse con el scheduler
+ *   bloqueado.
+ *
+ *  @param *task		tarea a suspender, o NULL para la tarea actual
  *  @return     none.
  *****************************************************************************/
-void os_InitTask(os_TaskHandler_t *taskHandler,
-		void* entryPoint,
-		uint8_t priority);
+void os_task_suspend(os_TaskHandler_t * task);
+
+/******************************************************************************
+ *  @brief Reanudación de una tarea suspendida
+ *
+ *  @param *task		tarea a reanudar (NULL no tiene efecto)
+ *  @return     none.
+ *****************************************************************************/
+void os_task_resume(os_TaskHandler_t * task);
 
 /******************************************************************************
  *  @brief Inicialización del sistema operativo
@@ -145,15 +287,28 @@ void os_InitTask(os_TaskHandler_t *taskHandler,
 void os_Init(void);
 
 /******************************************************************************
- *  @brief Obtiene el contexto siguiente
+ *  @brief Obtiene el contexto de la primer tarea a ejecutar
  *
  *  @details
- *   Esta obtiene el contexto de la próxima tarea a ser ejecutada
+ *   PendSV_Handler la llama solo en su primer ingreso luego del reset
+ *   (actualTask nulo). Los cambios de contexto siguientes se resuelven en
+ *   assembler a partir de nextTask, sin llamar a código C.
+ *
+ *  @return     stack pointer de la primer tarea.
+ *****************************************************************************/
+uint32_t os_getFirstContext(void);
+
+/******************************************************************************
+ *  @brief Decisión de scheduling diferida desde interrupciones
+ *
+ *  @details
+ *   PendSV_Handler la llama solo si una o más interrupciones liberaron
+ *   eventos (os_setSchedulingFromIRQ): la tarea siguiente se elige una única
+ *   vez, cuando PendSV se encadena luego de la última de ellas.
  *
- *  @param *p_stack_actual		puntero al stack de la tarea actual
  *  @return     none.
  *****************************************************************************/
-uint32_t getContextoSiguiente(uint32_t p_stack_actual);
+void os_scheduleFromPendSV(void);
 
 /******************************************************************************
  *  @brief Fuerza la ejecución del scheduler
@@ -167,6 +322,123 @@ uint32_t getContextoSiguiente(uint32_t p_stack_actual);
  *****************************************************************************/
 void os_CpuYield(void);
 
+/******************************************************************************
+ *  @brief Pasa una tarea bloqueada al estado ready
+ *
+ *  @details
+ *   Si la tarea despertada tiene mayor prioridad que la tarea actual se
+ *   fuerza el cambio de contexto en ese mismo momento, sin esperar al
+ *   próximo tick. Si se llama desde una interrupción, el scheduling se
+ *   difiere hasta la salida del handler.
+ *
+ *  @param *task		puntero a la tarea que pasa a estado ready
+ *  @return     none.
+ *****************************************************************************/
+void os_setTaskReady(os_TaskHandler_t * task);
+
+/******************************************************************************
+ *  @brief Cambia el estado de una tarea
+ *
+ *  @details
+ *   Todo cambio de estado de una tarea debe hacerse a través de esta rutina
+ *   para mantener actualizado el bitmap de prioridades con tareas listas
+ *   que utiliza el scheduler. No fuerza ningún scheduling.
+ *
+ *  @param *task		puntero a la tarea
+ *  @param newState		nuevo estado de la tarea
+ *  @return     none.
+ *****************************************************************************/
+void os_setTaskState(os_TaskHandler_t * task, os_TaskState_t newState);
+
+/******************************************************************************
+ *  @brief Bloquea la tarea actual con un timeout
+ *
+ *  @details
+ *   Solo cambia el estado de la tarea: el llamador debe registrarla como
+ *   tarea en espera del objeto correspondiente (en la misma sección
+ *   crítica) y luego llamar a os_CpuYield. Al volver, los ticks que
+ *   restan del timeout quedan en blockedTicks de la tarea; si llegaron a
+ *   cero, el timeout expiró.
+ *
+ *  @param timeout		ticks a esperar como máximo, u OS_WAIT_FOREVER
+ *  @return     puntero a la tarea bloqueada.
+ *****************************************************************************/
+os_TaskHandler_t* os_blockActualTask(uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Bloquea la tarea actual en espera de un objeto
+ *
+ *  @details
+ *   Igual que os_blockActualTask, pero además registra a la tarea en el
+ *   campo del objeto que apunta a la tarea en espera. Así, si la tarea se
+ *   elimina o suspende mientras espera, el kernel puede quitarla del
+ *   objeto. Debe llamarse dentro de una sección crítica.
+ *
+ *  @param **waitSlot	campo del objeto que apunta a la tarea en espera
+ *  @param timeout		ticks a esperar como máximo, u OS_WAIT_FOREVER
+ *  @return     puntero a la tarea bloqueada.
+ *****************************************************************************/
+os_TaskHandler_t* os_blockActualTaskOn(os_TaskHandler_t ** waitSlot, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Bloquea la tarea actual en la lista de espera de un objeto
+ *
+ *  @details
+ *   Para objetos por los que pueden esperar varias tareas. La lista se
+ *   ordena por prioridad y, entre tareas de igual prioridad, por orden de
+ *   llegada. Una tarea que sale del estado bloqueado (porque se la
+ *   despierta, expira su timeout, se suspende o se elimina) se quita de la
+ *   lista automáticamente. Debe llamarse dentro de una sección crítica.
+ *
+ *  @param **waitList	cabeza de la lista de espera (NULL si está vacía)
+ *  @param timeout		ticks a esperar como máximo, u OS_WAIT_FOREVER
+ *  @return     puntero a la tarea bloqueada.
+ *****************************************************************************/
+os_TaskHandler_t* os_blockActualTaskOnList(os_TaskHandler_t ** waitList, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Despierta a la tarea más prioritaria de una lista de espera
+ *
+ *  @details
+ *   Como os_wakeUpWaitingTask, para las listas de os_blockActualTaskOnList.
+ *   Para despertar a varias tareas sin que la primera desaloje a la actual
+ *   antes de despertar a las demás, debe llamarse dentro de una sección
+ *   crítica.
+ *
+ *  @param **waitList	cabeza de la lista de espera
+ *  @return     tarea despertada, o NULL si la lista estaba vacía.
+ *****************************************************************************/
+os_TaskHandler_t* os_wakeUpFirstWaitingTask(os_TaskHandler_t ** waitList);
+
+/******************************************************************************
+ *  @brief Despierta a la tarea que espera por un objeto del sistema operativo
+ *
+ *  @details
+ *   Si hay una tarea bloqueada esperando por el objeto, la pasa a ready. Si
+ *   dicha tarea tiene mayor prioridad que la actual, se produce el cambio
+ *   de contexto inmediatamente (o a la salida de la interrupción).
+ *
+ *  @param **waitingTask		campo del objeto que apunta a la tarea en espera
+ *  @return     none.
+ *****************************************************************************/
+void os_wakeUpWaitingTask(os_TaskHandler_t ** waitingTask);
+
+/******************************************************************************
+ *  @brief Calcula el timeout restante luego de una espera
+ *
+ *  @details
+ *   Se llama al volver de os_CpuYield luego de os_blockActualTask. Si el
+ *   timeout expiró, la tarea deja de figurar como tarea en espera del
+ *   objeto para no ser despertada más tarde por error.
+ *
+ *  @param **waitingTask		campo del objeto que apunta a la tarea en espera
+ *  @param *task				tarea que esperó
+ *  @param timeout				timeout con el que se bloqueó la tarea
+ *  @return     ticks restantes (OS_NO_WAIT si expiró).
+ *****************************************************************************/
+uint32_t os_getRemainingTimeout(os_TaskHandler_t ** waitingTask,
+		os_TaskHandler_t * task, uint32_t timeout);
+
 /******************************************************************************
  *  @brief Obtiene la tarea actual
  *
@@ -225,6 +497,34 @@ void os_enter_critical_zone();
  *****************************************************************************/
 void os_exit_critical_zone();
 
+/******************************************************************************
+ *  @brief Bloquea el scheduler
+ *
+ *  @details
+ *   A diferencia de la sección crítica, las interrupciones siguen
+ *   habilitadas: solo se impide que otra tarea desaloje a la actual. Los
+ *   schedulings pedidos mientras tanto (por el tick, por interrupciones o
+ *   por la propia tarea) se difieren y se ejecutan una única vez al
+ *   desbloquear. Es anidable. Mientras el scheduler está bloqueado la
+ *   tarea no debe bloquearse. No tiene efecto desde una interrupción.
+ *
+ *  @param 		none
+ *  @return     none
+ *****************************************************************************/
+void os_lock_scheduler(void);
+
+/******************************************************************************
+ *  @brief Desbloquea el scheduler
+ *
+ *  @details
+ *   Al salir del último nivel de anidamiento, si se difirió algún
+ *   scheduling, se ejecuta en ese momento.
+ *
+ *  @param 		none
+ *  @return     none
+ *****************************************************************************/
+void os_unlock_scheduler(void);
+
 /******************************************************************************
  *  @brief Deja una marca para indicar que se corre desde interrupción
  *
@@ -261,6 +561,20 @@ void os_clearSchedulingFromIRQ();
  *****************************************************************************/
 bool os_isSchedulingFromIRQ();
 
+/******************************************************************************
+ *  @brief Pide un scheduling diferido a la salida de una interrupción
+ *
+ *  @details
+ *   Solo activa PendSV. Al tener la menor prioridad, PendSV se encadena
+ *   luego de la última interrupción pendiente y allí se toma una única
+ *   decisión de scheduling, sin importar cuántas interrupciones hayan
+ *   liberado eventos.
+ *
+ *  @param 		none
+ *  @return     none
+ *****************************************************************************/
+void os_pendSchedulingFromIRQ();
+
 /******************************************************************************
  *  @brief Establece una situación de error
  *
@@ -273,6 +587,83 @@ bool os_isSchedulingFromIRQ();
  *****************************************************************************/
 void os_setError(os_control_error_t err, void* caller);
 
+/******************************************************************************
+ *  @brief Obtiene el último error del sistema operativo
+ *
+ *  @param 	none
+ *  @return   último error registrado (os_control_error_none si no hubo)
+ *****************************************************************************/
+os_control_error_t os_getError(void);
+
+/******************************************************************************
+ *  @brief Obtiene la cantidad de tareas de usuario creadas
+ *
+ *  @param 	none
+ *  @return   cantidad de tareas (sin contar la tarea idle)
+ *****************************************************************************/
+os_taskId_t os_getTaskCount(void);
+
+/******************************************************************************
+ *  @brief Obtiene una tarea a partir de su identificador
+ *
+ *  @details
+ *   Junto con os_getTaskCount permite recorrer las tareas, por ejemplo
+ *   para mostrar estadísticas. OS_IDLE_TASK_ID devuelve la tarea idle.
+ *
+ *  @param 	id			identificador de la tarea
+ *  @return   puntero a la tarea, NULL si no existe
+ *****************************************************************************/
+os_TaskHandler_t* os_getTask(os_taskId_t id);
+
+/******************************************************************************
+ *  @brief Obtiene el margen de stack que una tarea nunca utilizó
+ *
+ *  @details
+ *   El stack se pinta con OS_STACK_PAINT_PATTERN al crear la tarea; se
+ *   cuentan las palabras que conservan el patrón desde el fondo. Recorre el
+ *   stack sin sección crítica, por lo que puede llamarse desde una tarea de
+ *   baja prioridad sin afectar a las demás.
+ *
+ *  @param 	*task		tarea a analizar
+ *  @return   bytes del stack que nunca se escribieron
+ *****************************************************************************/
+uint32_t os_getStackFreeBytes(os_TaskHandler_t * task);
+
+/******************************************************************************
+ *  @brief Obtiene los ticks transcurridos desde el último reinicio de las
+ *         estadísticas
+ *
+ *  @details
+ *   La participación de cada tarea en el uso del CPU es su runTicks
+ *   dividido este valor. Se obtiene muestreando la tarea en ejecución en
+ *   cada tick, por lo que no agrega costo a los cambios de contexto.
+ *
+ *  @param 	none
+ *  @return   ticks desde el último os_resetTaskStats
+ *****************************************************************************/
+uint32_t os_getStatsTicks(void);
+
+/******************************************************************************
+ *  @brief Reinicia las estadísticas de uso del CPU de todas las tareas
+ *
+ *  @param 	none
+ *  @return   none
+ *****************************************************************************/
+void os_resetTaskStats(void);
+
+#ifdef OS_CONFIG_PROFILE_CYCLES
+/******************************************************************************
+ *  @brief Obtiene los ciclos de CPU medidos en el tick y el cambio de contexto
+ *
+ *  @details
+ *   Los máximos se reinician con os_resetTaskStats.
+ *
+ *  @param 	*cycles		estructura donde se copian las mediciones
+ *  @return   none
+ *****************************************************************************/
+void os_getKernelCycles(os_kernelCycles_t * cycles);
+#endif
+
 /******************************************************************************
  *  @brief Obtiene el tiempo actual del sistema operativo
  *
@@ -284,4 +675,25 @@ void os_setError(os_control_error_t err, void* caller);
  *****************************************************************************/
 uint32_t os_get_systemClockMs();
 
+/******************************************************************************
+ *  @brief Obtiene el tiempo actual del sistema operativo en microsegundos
+ *
+ *  @details
+ *   Reloj monótono de 64 bits que combina los ticks con el valor actual de
+ *   SysTick, por lo que su resolución no depende del período del tick.
+ *   Puede llamarse desde tareas e interrupciones.
+ *
+ *  @param 	none
+ *  @return   microsegundos desde que comenzó a ejecutarse el sistema operativo
+ *****************************************************************************/
+uint64_t os_get_systemClockUs(void);
+
+/******************************************************************************
+ *  @brief Obtiene la duración del tick del sistema operativo
+ *
+ *  @param 	none
+ *  @return   microsegundos por tick
+ *****************************************************************************/
+uint32_t os_get_tickPeriodUs(void);
+
 #endif /* ISO_I_2020_MSE_OS_INC_MSE_OS_CORE_H_ */
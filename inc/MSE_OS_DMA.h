@@ -0,0 +1,77 @@
+/*
+ * MSE_OS_DMA.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Librería que reparte la interrupción del GPDMA entre los
+ *         drivers del sistema operativo
+ *
+ *  Los 8 canales del GPDMA comparten una sola interrupción (DMA_IRQn). Cada
+ *  driver reserva un canal junto con un callback, que se ejecuta desde la
+ *  interrupción cuando el canal termina una transferencia (o un descriptor
+ *  con interrupción habilitada) o cuando se produce un error.
+ */
+
+#ifndef INC_MSE_OS_DMA_H_
+#define INC_MSE_OS_DMA_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "board.h"
+
+/*==================[macros and definitions]=================================*/
+#define OS_DMA_NUMBER_OF_CHANNELS	8
+#define OS_DMA_NO_CHANNEL			0xFF
+
+/** Tamaño máximo de una transferencia (campo de 12 bits del registro de control) */
+#define OS_DMA_MAX_TRANSFER_SIZE	4095
+
+/**
+ * Callback de un canal. Se ejecuta en contexto de interrupción.
+ *
+ * @param channel		canal que generó la interrupción
+ * @param error			true si la transferencia terminó con error
+ * @param *param		parámetro indicado al reservar el canal
+ */
+typedef void (*os_dma_callback_t)(uint8_t channel, bool error, void * param);
+
+/*==================[public functions]=======================================*/
+
+/******************************************************************************
+ *  @brief Inicialización del GPDMA.
+ *
+ *  @details
+ *   Registra el handler de DMA_IRQn. Puede llamarse más de una vez (por cada
+ *   driver que lo utilice); solo la primera tiene efecto.
+ *
+ *  @return     none.
+******************************************************************************/
+void os_dma_init(void);
+
+/******************************************************************************
+ *  @brief Reserva un canal del GPDMA.
+ *
+ *  @details
+ *   Se reserva el canal libre de mayor prioridad. Las transferencias se
+ *   programan luego con las funciones Chip_GPDMA_xxx de LPCOpen.
+ *
+ *  @param callback				rutina a ejecutar en la interrupción del canal
+ *  @param *param				parámetro que recibirá el callback
+ *  @return     canal reservado, u OS_DMA_NO_CHANNEL si no hay canales libres.
+******************************************************************************/
+uint8_t os_dma_allocChannel(os_dma_callback_t callback, void * param);
+
+/******************************************************************************
+ *  @brief Libera un canal del GPDMA.
+ *
+ *  @details
+ *   Detiene cualquier transferencia en curso del canal.
+ *
+ *  @param channel				canal a liberar
+ *  @return     none.
+******************************************************************************/
+void os_dma_freeChannel(uint8_t channel);
+
+#endif /* INC_MSE_OS_DMA_H_ */
@@ -0,0 +1,109 @@
+/*
+ * MSE_OS_DSP.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Rutinas de procesamiento de bloques de muestras q15 que
+ *         aprovechan las instrucciones SIMD del Cortex-M4
+ *
+ *  Todas las rutinas trabajan sobre el mismo bloque que reciben (por
+ *  ejemplo el bloque entregado por un doble buffer), sin copias adicionales
+ *  más allá de la historia que necesitan los filtros. Los bloques deben
+ *  tener una cantidad par de muestras y estar alineados a 4 bytes.
+ */
+
+#ifndef INC_MSE_OS_DSP_H_
+#define INC_MSE_OS_DSP_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "board.h"
+
+/*==================[macros and definitions]=================================*/
+
+/** Filtro FIR q15 con decimación opcional */
+typedef struct
+{
+	const int16_t * coeffs;		/** coeficientes en orden inverso (h[numTaps-1] primero) */
+	int16_t * state;			/** numTaps - 1 + blockSize muestras */
+	uint16_t numTaps;			/** cantidad par de coeficientes */
+	uint8_t decimation;			/** 1 = sin decimación */
+} os_dsp_fir_q15_t;
+
+/*==================[public functions]=======================================*/
+
+/******************************************************************************
+ *  @brief Conversión de lecturas crudas del ADC a q15.
+ *
+ *  @details
+ *   Toma el valor de 10 bits de cada registro de datos del ADC, lo centra
+ *   en cero y lo escala a q15. Puede trabajar en el lugar (dst apuntando al
+ *   mismo bloque que src): cada muestra q15 ocupa la mitad que la lectura.
+ *
+ *  @param *dst					muestras q15
+ *  @param *src					registros de datos leídos por el DMA
+ *  @param n					cantidad de muestras
+ *  @return     none.
+******************************************************************************/
+void os_dsp_adcToQ15(int16_t * dst, const uint32_t * src, uint32_t n);
+
+/******************************************************************************
+ *  @brief Suma con saturación de un offset a un bloque.
+ *
+ *  @details
+ *   Procesa dos muestras por instrucción (QADD16).
+ *
+ *  @param *block				bloque de muestras
+ *  @param n					cantidad de muestras (par)
+ *  @param offset				valor q15 a sumar
+ *  @return     none.
+******************************************************************************/
+void os_dsp_offset_q15(int16_t * block, uint32_t n, int16_t offset);
+
+/******************************************************************************
+ *  @brief Decimación por 2 promediando muestras consecutivas.
+ *
+ *  @details
+ *   Procesa cuatro muestras de entrada por iteración (SHADD16). El
+ *   resultado queda al comienzo del mismo bloque.
+ *
+ *  @param *block				bloque de muestras
+ *  @param n					cantidad de muestras (múltiplo de 4)
+ *  @return     cantidad de muestras resultantes.
+******************************************************************************/
+uint32_t os_dsp_decimate2_q15(int16_t * block, uint32_t n);
+
+/******************************************************************************
+ *  @brief Inicialización de un filtro FIR.
+ *
+ *  @param *fir					filtro
+ *  @param *coeffs				coeficientes en orden inverso (cantidad par:
+ *  							completar con un cero al comienzo si hace falta)
+ *  @param numTaps				cantidad de coeficientes
+ *  @param decimation			factor de decimación (1 = sin decimación)
+ *  @param *state				buffer de numTaps - 1 + blockSize muestras
+ *  @return     false si numTaps es cero o impar: el filtro queda inválido y
+ *  			os_dsp_fir_q15 no produce muestras.
+******************************************************************************/
+bool os_dsp_fir_init_q15(os_dsp_fir_q15_t * fir, const int16_t * coeffs,
+		uint16_t numTaps, uint8_t decimation, int16_t * state);
+
+/******************************************************************************
+ *  @brief Filtrado FIR (y decimación) de un bloque.
+ *
+ *  @details
+ *   Acumula de a dos productos por instrucción (SMLALD) en 64 bits y
+ *   satura el resultado a q15. Con decimación solo se calculan las muestras
+ *   que se conservan. El resultado queda al comienzo del mismo bloque.
+ *
+ *  @param *fir					filtro
+ *  @param *block				bloque de muestras
+ *  @param n					cantidad de muestras (múltiplo de la decimación,
+ *  							hasta el blockSize del estado)
+ *  @return     cantidad de muestras resultantes.
+******************************************************************************/
+uint32_t os_dsp_fir_q15(os_dsp_fir_q15_t * fir, int16_t * block, uint32_t n);
+
+#endif /* INC_MSE_OS_DSP_H_ */
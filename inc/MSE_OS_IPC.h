@@ -0,0 +1,131 @@
+/*
+ * MSE_OS_IPC.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Librería que contiene la comunicación entre el núcleo M4
+ *         y el co-procesador M0APP del LPC4337
+ *
+ *  La comunicación se realiza con dos rings lock-free (un productor y un
+ *  consumidor cada uno) ubicados en memoria compartida, uno por sentido.
+ *  Luego de escribir en un ring, el núcleo productor ejecuta SEV, lo que
+ *  genera la interrupción entre núcleos en el otro núcleo.
+ *
+ *  En ambos núcleos los mensajes recibidos se entregan en una cola del
+ *  sistema operativo: del lado del M4 una os_Queue_t, y del lado del M0APP
+ *  una os_m0_queue_t del scheduler mínimo (MSE_OS_M0.h), que despierta a
+ *  la tarea de recepción. Los rings se implementan en MSE_OS_IpcRing.h.
+ */
+
+#ifndef INC_MSE_OS_IPC_H_
+#define INC_MSE_OS_IPC_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "MSE_OS_Config.h"
+#include "MSE_OS_IpcRing.h"
+
+#if defined(CORE_M0)
+#include "MSE_OS_M0.h"
+#else
+#include "MSE_OS_API.h"
+#endif
+
+/*==================[public functions]=======================================*/
+
+#if defined(CORE_M0)
+
+/******************************************************************************
+ *  @brief Inicialización de la comunicación del lado del M0APP.
+ *
+ *  @details
+ *   Espera a que el M4 haya inicializado la memoria compartida y habilita
+ *   la interrupción entre núcleos. Los mensajes recibidos se entregan en
+ *   la cola, que despierta a su tarea asociada.
+ *
+ *  @param *rxQueue				cola (inicializada con elementos de tamaño
+ *  							sizeof(os_ipcMessage_t)) en la que se
+ *  							entregan los mensajes del M4
+ *  @return     none.
+******************************************************************************/
+void os_ipc_init(os_m0_queue_t * rxQueue);
+
+/******************************************************************************
+ *  @brief Envío de un mensaje al M4.
+ *
+ *  @details
+ *   Las tareas del M0APP no se bloquean: si el ring está lleno el mensaje
+ *   no se envía.
+ *
+ *  @param *msg					mensaje a enviar
+ *  @return     true si había lugar en el ring.
+******************************************************************************/
+bool os_ipc_send(const os_ipcMessage_t * msg);
+
+/******************************************************************************
+ *  @brief Recepción de un mensaje enviado por el M4.
+ *
+ *  @details
+ *   Retira un mensaje de la cola de recepción, sin bloquear. La tarea de
+ *   recepción debe llamarla hasta que retorne false.
+ *
+ *  @param *msg					mensaje recibido
+ *  @return     true si había un mensaje.
+******************************************************************************/
+bool os_ipc_receive(os_ipcMessage_t * msg);
+
+#else
+
+/******************************************************************************
+ *  @brief Inicialización de la comunicación del lado del M4.
+ *
+ *  @details
+ *   Inicializa la memoria compartida y registra el handler de la
+ *   interrupción M0APP_IRQn. Debe llamarse antes de arrancar el M0APP.
+ *
+ *  @param *rxQueue				cola (inicializada con elementos de tamaño
+ *  							sizeof(os_ipcMessage_t)) en la que se
+ *  							entregan los mensajes del M0APP
+ *  @return     none.
+******************************************************************************/
+void os_ipc_init(os_Queue_t * rxQueue);
+
+/******************************************************************************
+ *  @brief Arranque del núcleo M0APP.
+ *
+ *  @param imageAddress			dirección de la imagen del M0APP
+ *  @return     none.
+******************************************************************************/
+void os_ipc_startM0(uint32_t imageAddress);
+
+/******************************************************************************
+ *  @brief Envío de un mensaje al M0APP.
+ *
+ *  @details
+ *   Puede llamarse desde varias tareas e interrupciones: las escrituras
+ *   en el ring se serializan en una sección crítica. Si el ring está lleno
+ *   la tarea queda bloqueada hasta que el M0APP consuma un mensaje; las
+ *   tareas en espera envían en orden de prioridad. Desde una interrupción
+ *   no se bloquea y el mensaje se descarta.
+ *
+ *  @param *msg					mensaje a enviar
+ *  @return     true si el mensaje fue enviado.
+******************************************************************************/
+bool os_ipc_send(const os_ipcMessage_t * msg);
+
+/******************************************************************************
+ *  @brief Recepción de un mensaje enviado por el M0APP.
+ *
+ *  @details
+ *   Bloquea a la tarea hasta que haya un mensaje en la cola de recepción.
+ *
+ *  @param *msg					mensaje recibido
+ *  @return     none.
+******************************************************************************/
+void os_ipc_receive(os_ipcMessage_t * msg);
+
+#endif
+
+#endif /* INC_MSE_OS_IPC_H_ */
@@ -0,0 +1,94 @@
+/*
+ * MSE_OS_IpcRing.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Rings lock-free de un productor y un consumidor utilizados
+ *         por la comunicación entre núcleos (MSE_OS_IPC.h)
+ *
+ *  No dependen del sistema operativo ni del núcleo en el que se ejecutan,
+ *  solo de las barreras de memoria de board.h, por lo que se comparten
+ *  entre las imágenes del M4 y del M0APP y pueden probarse en el host.
+ */
+
+#ifndef INC_MSE_OS_IPCRING_H_
+#define INC_MSE_OS_IPCRING_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "MSE_OS_Config.h"
+
+/*==================[macros and definitions]=================================*/
+#define OS_IPC_MAGIC	0x4D53454F		/** "MSEO": memoria compartida inicializada */
+
+typedef struct
+{
+	uint32_t id;		/** identificador del mensaje, definido por la aplicación */
+	uint32_t param;		/** dato o puntero a memoria compartida */
+} os_ipcMessage_t;
+
+typedef struct
+{
+	volatile uint32_t head;		/** solo lo escribe el productor */
+	volatile uint32_t tail;		/** solo lo escribe el consumidor */
+	os_ipcMessage_t buffer[OS_CONFIG_IPC_RING_SIZE];
+} os_ipcRing_t;
+
+typedef struct
+{
+	volatile uint32_t magic;
+	os_ipcRing_t m4ToM0;
+	os_ipcRing_t m0ToM4;
+} os_ipcShared_t;
+
+
+/*==================[public functions]=======================================*/
+
+/******************************************************************************
+ *  @brief Inicialización de un ring.
+ *
+ *  @details
+ *   Solo puede llamarse mientras ningún núcleo usa el ring.
+ *
+ *  @param *ring				ring a inicializar
+ *  @return     none.
+******************************************************************************/
+void os_ipc_ringInit(os_ipcRing_t * ring);
+
+/******************************************************************************
+ *  @brief Escritura de un mensaje en un ring.
+ *
+ *  @details
+ *   No bloqueante y sin secciones críticas: solo puede haber un productor
+ *   por ring. No depende del hardware más allá de las barreras de memoria.
+ *
+ *  @param *ring				ring en el que se escribe
+ *  @param *msg					mensaje a escribir
+ *  @return     true si había lugar en el ring.
+******************************************************************************/
+bool os_ipc_ringPut(os_ipcRing_t * ring, const os_ipcMessage_t * msg);
+
+/******************************************************************************
+ *  @brief Lectura de un mensaje de un ring.
+ *
+ *  @details
+ *   No bloqueante y sin secciones críticas: solo puede haber un consumidor
+ *   por ring.
+ *
+ *  @param *ring				ring del que se lee
+ *  @param *msg					mensaje leído
+ *  @return     true si había un mensaje en el ring.
+******************************************************************************/
+bool os_ipc_ringGet(os_ipcRing_t * ring, os_ipcMessage_t * msg);
+
+/******************************************************************************
+ *  @brief Indica si un ring está lleno.
+ *
+ *  @param *ring				ring a analizar
+ *  @return     true si el ring está lleno.
+******************************************************************************/
+bool os_ipc_ringIsFull(os_ipcRing_t * ring);
+
+#endif /* INC_MSE_OS_IPCRING_H_ */
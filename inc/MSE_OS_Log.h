@@ -0,0 +1,105 @@
+/*
+ * MSE_OS_Log.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Librería de logging binario diferido
+ *
+ *  Quien registra un evento solo guarda el ID de su string de formato y los
+ *  argumentos crudos en un buffer lock-free, lo que toma pocos ciclos y puede
+ *  hacerse desde cualquier tarea o interrupción. El formateo lo hace más tarde
+ *  una tarea de baja prioridad (os_log_format) o un decodificador en la PC a
+ *  partir de los registros crudos (os_log_readRecord). Cada núcleo tiene su
+ *  propio buffer.
+ *
+ *  Los argumentos se guardan como uint32_t, por lo que los formatos solo deben
+ *  usar conversiones de 32 bits (%u, %d, %x, %c) o %s con punteros a strings
+ *  constantes, que siguen siendo válidos al momento de formatear.
+ */
+
+#ifndef INC_MSE_OS_LOG_H_
+#define INC_MSE_OS_LOG_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "MSE_OS_Config.h"
+
+/*==================[macros and definitions]=================================*/
+#define OS_LOG_MAX_ARGS		4
+
+typedef struct
+{
+	uint16_t formatId;
+	uint8_t nArgs;
+	uint32_t timestamp;		/** ticks del sistema al momento del registro */
+	uint32_t args[OS_LOG_MAX_ARGS];
+} os_logRecord_t;
+
+#define OS_LOG0(id)					os_log_record((id), 0, 0, 0, 0, 0)
+#define OS_LOG1(id, a)				os_log_record((id), 1, (uint32_t)(a), 0, 0, 0)
+#define OS_LOG2(id, a, b)			os_log_record((id), 2, (uint32_t)(a), (uint32_t)(b), 0, 0)
+#define OS_LOG3(id, a, b, c)		os_log_record((id), 3, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), 0)
+#define OS_LOG4(id, a, b, c, d)		os_log_record((id), 4, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d))
+
+/*==================[public functions]=======================================*/
+
+/******************************************************************************
+ *  @brief Inicialización del log.
+ *
+ *  @param *formats				tabla de strings de formato, indexada por ID
+ *  @param numberOfFormats		cantidad de elementos de la tabla
+ *  @return     none.
+******************************************************************************/
+void os_log_init(const char * const * formats, uint16_t numberOfFormats);
+
+/******************************************************************************
+ *  @brief Registra un evento.
+ *
+ *  @details
+ *   Puede llamarse desde tareas de cualquier prioridad e interrupciones. No
+ *   bloquea ni deshabilita interrupciones: el espacio se reserva con
+ *   LDREX/STREX. Si el buffer está lleno el evento se descarta y se cuenta.
+ *   Usar las macros OS_LOGn.
+ *
+ *  @param formatId				ID del string de formato
+ *  @param nArgs				cantidad de argumentos válidos
+ *  @return     none.
+******************************************************************************/
+void os_log_record(uint16_t formatId, uint8_t nArgs,
+		uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+
+/******************************************************************************
+ *  @brief Lee el registro crudo más antiguo.
+ *
+ *  @details
+ *   Solo debe haber un lector. Pensada para enviar los registros a un
+ *   decodificador en la PC.
+ *
+ *  @param *record				registro leído
+ *  @return     true si había un registro completo para leer.
+******************************************************************************/
+bool os_log_readRecord(os_logRecord_t * record);
+
+/******************************************************************************
+ *  @brief Lee y formatea el registro más antiguo.
+ *
+ *  @details
+ *   Solo debe haber un lector, normalmente una tarea de baja prioridad.
+ *
+ *  @param *buffer				destino del texto formateado
+ *  @param size					tamaño del destino
+ *  @return     true si se formateó un registro.
+******************************************************************************/
+bool os_log_format(char * buffer, size_t size);
+
+/******************************************************************************
+ *  @brief Cantidad de eventos descartados por falta de espacio.
+ *
+ *  @return     eventos descartados desde el arranque.
+******************************************************************************/
+uint32_t os_log_getDropped(void);
+
+#endif /* INC_MSE_OS_LOG_H_ */
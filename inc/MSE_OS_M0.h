@@ -0,0 +1,128 @@
+/*
+ * MSE_OS_M0.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Scheduler mínimo para el co-procesador Cortex-M0 (M0APP)
+ *
+ *  Pensado para descargar del M4 tareas dominadas por E/S (por ejemplo el
+ *  manejo de protocolos). Las tareas son rutinas que corren hasta completarse
+ *  cada vez que se las despierta, todas sobre el mismo stack, por lo que no
+ *  hay cambio de contexto. La prioridad de cada tarea es también su ID
+ *  (0 es la mayor prioridad). Solo se compila en la imagen del M0APP
+ *  (CORE_M0 definido, ver el target m0app del Makefile).
+ *
+ *  Como las tareas no pueden bloquearse, las colas del M0APP no esperan:
+ *  insertar un elemento despierta a la tarea asociada a la cola, que lo
+ *  retira en su próxima ejecución.
+ */
+
+#ifndef INC_MSE_OS_M0_H_
+#define INC_MSE_OS_M0_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "MSE_OS_Config.h"
+
+/*==================[macros and definitions]=================================*/
+typedef void (*os_m0_taskHandler_t)(void);
+
+/** Cola de elementos de tamaño fijo sobre memoria provista por la aplicación */
+typedef struct
+{
+	uint8_t * storage; /** maxElements * elementSize bytes */
+	uint16_t elementSize; /** element size in bytes */
+	uint16_t maxElements; /** queue capacity */
+	volatile uint16_t head; /** insertion index */
+	volatile uint16_t tail; /** removal index */
+	volatile uint16_t size; /** elements currently in the queue */
+	uint8_t taskToSignal; /** task woken on every insertion */
+} os_m0_queue_t;
+
+/*==================[public functions]=======================================*/
+
+/******************************************************************************
+ *  @brief Agrega una tarea al scheduler del M0APP.
+ *
+ *  @param priority				prioridad (e ID) de la tarea, entre 0 y
+ *  							OS_CONFIG_M0_MAX_TASKS-1
+ *  @param handler				rutina que se ejecuta cada vez que la
+ *  							tarea es despertada
+ *  @return     true si tuvo éxito.
+******************************************************************************/
+bool os_m0_addTask(uint8_t priority, os_m0_taskHandler_t handler);
+
+/******************************************************************************
+ *  @brief Despierta a una tarea.
+ *
+ *  @details
+ *   Puede llamarse desde interrupciones. Varias señales antes de que la
+ *   tarea se ejecute se atienden con una sola ejecución.
+ *
+ *  @param priority				prioridad (e ID) de la tarea
+ *  @return     none.
+******************************************************************************/
+void os_m0_signalTask(uint8_t priority);
+
+/******************************************************************************
+ *  @brief Ejecuta el scheduler del M0APP. No retorna.
+ *
+ *  @details
+ *   Ejecuta siempre la tarea despierta de mayor prioridad. Si no hay
+ *   ninguna, duerme al núcleo hasta la próxima interrupción.
+ *
+ *  @return     none.
+******************************************************************************/
+void os_m0_run(void);
+
+/******************************************************************************
+ *  @brief Inicialización de una cola del M0APP.
+ *
+ *  @param *queue				puntero a la cola
+ *  @param *storage				memoria para maxElements elementos
+ *  @param elementSize			tamaño en bytes de cada elemento
+ *  @param maxElements			capacidad de la cola
+ *  @param taskPriority			tarea a despertar en cada inserción
+ *  @return     none.
+******************************************************************************/
+void os_m0_queue_init(os_m0_queue_t * queue, void * storage, uint16_t elementSize,
+		uint16_t maxElements, uint8_t taskPriority);
+
+/******************************************************************************
+ *  @brief Inserta un elemento en una cola del M0APP.
+ *
+ *  @details
+ *   No bloqueante. Puede llamarse desde interrupciones. Despierta a la
+ *   tarea asociada a la cola.
+ *
+ *  @param *queue				puntero a la cola
+ *  @param *data				elemento a insertar
+ *  @return     true si había lugar en la cola.
+******************************************************************************/
+bool os_m0_queue_insert(os_m0_queue_t * queue, const void * data);
+
+/******************************************************************************
+ *  @brief Retira un elemento de una cola del M0APP.
+ *
+ *  @details
+ *   No bloqueante: la tarea asociada debe retirar elementos hasta vaciar
+ *   la cola y luego retornar, y vuelve a ejecutarse con la próxima
+ *   inserción.
+ *
+ *  @param *queue				puntero a la cola
+ *  @param *data				elemento retirado
+ *  @return     true si había un elemento.
+******************************************************************************/
+bool os_m0_queue_remove(os_m0_queue_t * queue, void * data);
+
+/******************************************************************************
+ *  @brief Indica si una cola del M0APP está llena.
+ *
+ *  @param *queue				puntero a la cola
+ *  @return     true si la cola está llena.
+******************************************************************************/
+bool os_m0_queue_isFull(os_m0_queue_t * queue);
+
+#endif /* INC_MSE_OS_M0_H_ */
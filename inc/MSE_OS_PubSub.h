@@ -0,0 +1,128 @@
+/*
+ * MSE_OS_PubSub.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Bus de eventos publicador/suscriptor sin copias
+ *
+ *  El publicador toma un mensaje de un pool, lo completa y lo publica en un
+ *  tópico. Cada suscriptor del tópico recibe un puntero al mismo mensaje en
+ *  su propia cola, por lo que el costo de publicar no depende del tamaño
+ *  del mensaje. El mensaje vuelve al pool cuando el último suscriptor lo
+ *  libera.
+ */
+
+#ifndef INC_MSE_OS_PUBSUB_H_
+#define INC_MSE_OS_PUBSUB_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "MSE_OS_API.h"
+
+/*==================[macros and definitions]=================================*/
+
+/** Qué hacer cuando la cola de un suscriptor está llena */
+typedef enum
+{
+	os_pubsub_policy__drop,		/** el suscriptor no recibe el mensaje */
+	os_pubsub_policy__block		/** el publicador espera (desde una interrupción se descarta) */
+} os_PubSubPolicy_t;
+
+typedef struct os_Subscriber
+{
+	os_Queue_t queue;				/** punteros a los mensajes recibidos */
+	os_PubSubPolicy_t policy;
+	uint32_t dropped;				/** mensajes descartados por cola llena */
+	struct os_Subscriber * next;	/** siguiente suscriptor del tópico */
+} os_Subscriber_t;
+
+typedef struct
+{
+	os_Subscriber_t * subscribers;
+} os_Topic_t;
+
+/*==================[public functions]=======================================*/
+
+/******************************************************************************
+ *  @brief Inicialización del pool de mensajes.
+ *
+ *  @details
+ *   Debe llamarse antes de os_Init.
+ *
+ *  @return     none.
+******************************************************************************/
+void os_pubsub_init(void);
+
+/******************************************************************************
+ *  @brief Inicialización de un tópico.
+ *
+ *  @param *topic				puntero al tópico
+ *  @return     none.
+******************************************************************************/
+void os_topic_init(os_Topic_t * topic);
+
+/******************************************************************************
+ *  @brief Suscripción a un tópico.
+ *
+ *  @details
+ *   Debe hacerse antes de publicar en el tópico (normalmente antes de
+ *   os_Init). La estructura del suscriptor pertenece a la tarea que recibe.
+ *
+ *  @param *topic				tópico
+ *  @param *subscriber			suscriptor
+ *  @param policy				política ante la cola llena
+ *  @return     none.
+******************************************************************************/
+void os_pubsub_subscribe(os_Topic_t * topic, os_Subscriber_t * subscriber,
+		os_PubSubPolicy_t policy);
+
+/******************************************************************************
+ *  @brief Toma un mensaje del pool.
+ *
+ *  @details
+ *   No bloquea y puede llamarse desde una interrupción.
+ *
+ *  @return     puntero a OS_PUBSUB_MESSAGE_SIZE bytes, NULL si el pool
+ *  			está agotado.
+******************************************************************************/
+void * os_pubsub_alloc(void);
+
+/******************************************************************************
+ *  @brief Publica un mensaje en un tópico.
+ *
+ *  @details
+ *   El mensaje debe haberse obtenido con os_pubsub_alloc y el publicador no
+ *   debe modificarlo ni liberarlo luego de publicarlo. Si ningún suscriptor
+ *   lo recibe, vuelve al pool.
+ *
+ *  @param *topic				tópico
+ *  @param *message				mensaje a publicar
+ *  @return     cantidad de suscriptores que recibieron el mensaje.
+******************************************************************************/
+uint8_t os_pubsub_publish(os_Topic_t * topic, void * message);
+
+/******************************************************************************
+ *  @brief Recepción de un mensaje.
+ *
+ *  @details
+ *   Bloquea a la tarea hasta que haya un mensaje. El mensaje es de solo
+ *   lectura, ya que lo comparten todos los suscriptores. Desde una
+ *   interrupción no bloquea.
+ *
+ *  @param *subscriber			suscriptor
+ *  @return     puntero al mensaje, o NULL si se llamó desde una interrupción
+ *  			y no había mensajes.
+******************************************************************************/
+const void * os_pubsub_receive(os_Subscriber_t * subscriber);
+
+/******************************************************************************
+ *  @brief Libera un mensaje recibido.
+ *
+ *  @param *message				mensaje
+ *  @return     none.
+******************************************************************************/
+void os_pubsub_release(const void * message);
+
+#endif /* INC_MSE_OS_PUBSUB_H_ */
@@ -0,0 +1,52 @@
+/*
+ * MSE_OS_Shell.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Consola de diagnóstico del sistema operativo
+ *
+ *  Atiende comandos de texto recibidos por una UART y responde con las
+ *  estadísticas del kernel: tareas, uso del CPU, margen de stack, ocupación
+ *  de las colas y último error. Solo lee contadores que el kernel ya
+ *  mantiene, sin secciones críticas largas, por lo que puede ejecutarse en
+ *  la tarea de menor prioridad sin afectar a las tareas de tiempo real.
+ *
+ *  Comandos:
+ *   help	lista los comandos
+ *   tasks	tareas, estado, uso del CPU y stack libre
+ *   queues	ocupación, pico y cantidad de esperas de cada cola
+ *   error	último error del kernel
+ *   reset	reinicia los contadores de tareas y colas
+ *   cycles	ciclos del tick y del cambio de contexto (con OS_CONFIG_PROFILE_CYCLES)
+ */
+
+#ifndef INC_MSE_OS_SHELL_H_
+#define INC_MSE_OS_SHELL_H_
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_Uart.h"
+
+/*==================[public functions]=======================================*/
+
+/******************************************************************************
+ *  @brief Inicialización de la consola.
+ *
+ *  @param *port				UART ya inicializada por la que se atiende
+ *  @return     none.
+******************************************************************************/
+void os_shell_init(os_Uart_t * port);
+
+/******************************************************************************
+ *  @brief Atiende los comandos recibidos.
+ *
+ *  @details
+ *   No bloquea esperando caracteres: procesa los ya recibidos y ejecuta
+ *   cada línea completa. Debe llamarse periódicamente desde una tarea de
+ *   baja prioridad, que es la única que debe escribir en la UART.
+ *
+ *  @return     none.
+******************************************************************************/
+void os_shell_poll(void);
+
+#endif /* INC_MSE_OS_SHELL_H_ */
@@ -0,0 +1,77 @@
+/*
+ * MSE_OS_Sst.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Handlers de eventos run-to-completion sobre un único stack
+ *
+ *  Un handler es una función que recibe un evento y termina sin bloquearse.
+ *  Todos los handlers se ejecutan sobre el stack de una única tarea del
+ *  kernel, por lo que no necesitan TCB ni stack propios. Cada handler tiene
+ *  una prioridad propia (0 es la mayor) y una cola de eventos.
+ *
+ *  La expropiación entre handlers se hace con llamadas anidadas: si un
+ *  handler publica un evento para otro de mayor prioridad, este se ejecuta
+ *  inmediatamente dentro de la publicación y al terminar se continúa con el
+ *  primero. Los eventos publicados desde interrupciones u otras tareas
+ *  despiertan a la tarea anfitriona y, si ya está ejecutando un handler, se
+ *  atienden por prioridad en cuanto este termina.
+ *
+ *  No hay expropiación asíncrona: un evento publicado desde una interrupción
+ *  nunca interrumpe al handler en curso, aunque su destinatario tenga mayor
+ *  prioridad. Su latencia incluye lo que reste del handler en ejecución, por
+ *  lo que los handlers deben ser cortos; lo que necesite una respuesta
+ *  acotada frente a interrupciones debe ser una tarea del kernel.
+ */
+
+#ifndef INC_MSE_OS_SST_H_
+#define INC_MSE_OS_SST_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "MSE_OS_Core.h"
+
+/*==================[macros and definitions]=================================*/
+typedef void (*os_sstHandler_t)(uint32_t event);
+
+/*==================[public functions]=======================================*/
+
+/******************************************************************************
+ *  @brief Inicialización de los handlers run-to-completion.
+ *
+ *  @details
+ *   Crea la tarea anfitriona con la prioridad del kernel indicada. Debe
+ *   llamarse antes de os_Init.
+ *
+ *  @param taskPriority			prioridad de la tarea anfitriona
+ *  @return     puntero a la tarea anfitriona, NULL si falló.
+******************************************************************************/
+os_TaskHandler_t * os_sst_init(uint8_t taskPriority);
+
+/******************************************************************************
+ *  @brief Registro de un handler.
+ *
+ *  @param priority				prioridad del handler (0 a
+ *  							OS_CONFIG_SST_PRIORITIES - 1, 0 es la mayor)
+ *  @param handler				función que atiende los eventos
+ *  @return     false si la prioridad no existe o ya está ocupada.
+******************************************************************************/
+bool os_sst_register(uint8_t priority, os_sstHandler_t handler);
+
+/******************************************************************************
+ *  @brief Publicación de un evento para un handler.
+ *
+ *  @details
+ *   No bloquea: puede llamarse desde handlers, tareas e interrupciones.
+ *   Solo desde un handler el destinatario más prioritario se ejecuta dentro
+ *   de la llamada.
+ *
+ *  @param priority				prioridad del handler destinatario
+ *  @param event				evento a entregar
+ *  @return     false si la cola de eventos del handler estaba llena.
+******************************************************************************/
+bool os_sst_post(uint8_t priority, uint32_t event);
+
+#endif /* INC_MSE_OS_SST_H_ */
@@ -0,0 +1,67 @@
+/*
+ * MSE_OS_Timer.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Esperas de alta resolución del sistema operativo
+ *
+ *  Permiten bloquear una tarea hasta un instante absoluto expresado en
+ *  microsegundos del reloj os_get_systemClockUs, sin aumentar la frecuencia
+ *  del tick. La parte de la espera que abarca ticks completos se hace con
+ *  os_Delay y el resto con una interrupción de match de un timer de
+ *  hardware que corre libre a 1 MHz.
+ */
+
+#ifndef INC_MSE_OS_TIMER_H_
+#define INC_MSE_OS_TIMER_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include "MSE_OS_Core.h"
+
+/*==================[public functions]=======================================*/
+
+/******************************************************************************
+ *  @brief Inicialización del timer de alta resolución.
+ *
+ *  @details
+ *   Utiliza el timer OS_CONFIG_HR_TIMER. Debe llamarse antes de os_Init.
+ *
+ *  @return     none.
+******************************************************************************/
+void os_timer_init(void);
+
+/******************************************************************************
+ *  @brief Espera hasta un instante absoluto.
+ *
+ *  @details
+ *   Si el instante ya pasó, retorna inmediatamente. No puede llamarse
+ *   desde una interrupción.
+ *
+ *  @param deadlineUs			instante en microsegundos de os_get_systemClockUs
+ *  @return     none.
+******************************************************************************/
+void os_timer_sleepUntilUs(uint64_t deadlineUs);
+
+/******************************************************************************
+ *  @brief Espera relativa con resolución de microsegundos.
+ *
+ *  @param us					microsegundos a esperar
+ *  @return     none.
+******************************************************************************/
+void os_timer_sleepUs(uint32_t us);
+
+/******************************************************************************
+ *  @brief Quita a una tarea de la lista de tareas dormidas.
+ *
+ *  @details
+ *   La llama os_task_delete: el nodo de espera vive en el stack de la tarea,
+ *   que vuelve al pool. Si la tarea no estaba dormida no tiene efecto.
+ *
+ *  @param *task				tarea eliminada
+ *  @return     none.
+******************************************************************************/
+void os_timer_removeTask(os_TaskHandler_t * task);
+
+#endif /* INC_MSE_OS_TIMER_H_ */
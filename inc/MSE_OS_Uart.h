@@ -0,0 +1,134 @@
+/*
+ * MSE_OS_Uart.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Driver de UART del sistema operativo basado en GPDMA
+ *
+ *  La transmisión se hace con una transferencia del GPDMA y la tarea que
+ *  escribe queda bloqueada hasta que termina, sin ocupar el CPU. La
+ *  recepción la hace el GPDMA de forma continua sobre un buffer circular
+ *  (dos descriptores enlazados entre sí). Las tareas lectoras se despiertan
+ *  al completarse cada mitad del buffer y cuando la UART detecta la línea
+ *  inactiva (interrupción de timeout de caracter, CTI). Esa interrupción
+ *  solo se habilita mientras una lectora espera: con el FIFO en manos del
+ *  GPDMA podría dispararse continuamente.
+ *
+ *  Contando las mitades completadas se detecta cuando el GPDMA alcanza datos
+ *  no leídos (OS_UART_ERROR_OVERRUN). Los errores de línea y del GPDMA
+ *  también se acumulan y se consultan con os_uart_getErrors.
+ *
+ *  Cada puerto admite una tarea escritora y una tarea lectora a la vez. El
+ *  ruteo de pines (SCU) queda a cargo de la aplicación.
+ */
+
+#ifndef INC_MSE_OS_UART_H_
+#define INC_MSE_OS_UART_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "board.h"
+#include "MSE_OS_Core.h"
+
+/*==================[macros and definitions]=================================*/
+typedef enum
+{
+	os_uart_0,
+	os_uart_1,
+	os_uart_2,		/** UART_USB de la EDU-CIAA */
+	os_uart_3,
+	os_uart_count
+} os_uart_id_t;
+
+/* Errores informados por os_uart_getErrors */
+#define OS_UART_ERROR_OVERRUN	0x01	/** el GPDMA sobrescribió datos no leídos */
+#define OS_UART_ERROR_LINE		0x02	/** paridad, trama, break u overrun del FIFO */
+#define OS_UART_ERROR_DMA		0x04	/** error de bus en una transferencia del GPDMA */
+
+typedef struct
+{
+	os_uart_id_t id;
+	uint8_t txChannel;
+	uint8_t rxChannel;
+	volatile bool txBusy;
+	volatile bool txError;
+	volatile bool rxStopped;		/** the RX channel stopped on a DMA error */
+	volatile bool rxErrorWakeUp;	/** wake the reader once for each new error */
+	volatile uint8_t errors;		/** OS_UART_ERROR_xxx not yet reported */
+	volatile uint32_t rxHalves;		/** RX buffer halves completed by the GPDMA */
+	uint32_t rxRead;				/** bytes consumed since reception started */
+	uint16_t rxTail;
+	os_TaskHandler_t * txWaiting;
+	os_TaskHandler_t * rxWaiting;
+	DMA_TransferDescriptor_t rxDescriptors[2];
+	uint8_t rxBuffer[OS_UART_RX_BUFFER_SIZE];
+} os_Uart_t;
+
+/*==================[public functions]=======================================*/
+
+/******************************************************************************
+ *  @brief Inicialización de un puerto.
+ *
+ *  @details
+ *   Configura la UART (8N1), reserva dos canales del GPDMA y arranca la
+ *   recepción continua. Debe llamarse antes de os_Init.
+ *
+ *  @param *port				estructura del puerto
+ *  @param id					UART a utilizar
+ *  @param baudRate				velocidad en baudios
+ *  @return     true si tuvo éxito.
+******************************************************************************/
+bool os_uart_init(os_Uart_t * port, os_uart_id_t id, uint32_t baudRate);
+
+/******************************************************************************
+ *  @brief Transmisión de datos.
+ *
+ *  @details
+ *   La tarea queda bloqueada hasta que el GPDMA entrega el último byte a la
+ *   UART. Los datos deben estar en memoria accesible por el GPDMA. No puede
+ *   llamarse desde una interrupción.
+ *
+ *  @param *port				puerto
+ *  @param *data				datos a transmitir
+ *  @param length				cantidad de bytes
+ *  @return     bytes transmitidos.
+******************************************************************************/
+uint32_t os_uart_write(os_Uart_t * port, const void * data, uint32_t length);
+
+/******************************************************************************
+ *  @brief Recepción de datos.
+ *
+ *  @details
+ *   Devuelve los bytes recibidos hasta el momento. Si no hay ninguno, la
+ *   tarea queda bloqueada hasta que llegue una ráfaga o expire el timeout.
+ *   La tarea debe leer con la frecuencia suficiente para que el GPDMA no
+ *   sobrescriba datos no leídos (OS_UART_RX_BUFFER_SIZE). Si lo hace, los
+ *   datos del buffer se descartan y se informa OS_UART_ERROR_OVERRUN.
+ *
+ *   Cada error nuevo despierta a la lectora, que retorna sin datos: debe
+ *   consultarse os_uart_getErrors. Si el error fue del GPDMA, la recepción
+ *   se reinicia en la próxima lectura.
+ *
+ *  @param *port				puerto
+ *  @param *data				destino de los datos
+ *  @param maxLength			tamaño del destino
+ *  @param timeout				ticks a esperar como máximo, OS_NO_WAIT u
+ *  							OS_WAIT_FOREVER
+ *  @return     bytes leídos.
+******************************************************************************/
+uint16_t os_uart_read(os_Uart_t * port, void * data, uint16_t maxLength, uint32_t timeout);
+
+/******************************************************************************
+ *  @brief Errores del puerto.
+ *
+ *  @details
+ *   Devuelve los errores ocurridos desde la consulta anterior y los limpia.
+ *
+ *  @param *port				puerto
+ *  @return     combinación de OS_UART_ERROR_xxx, 0 si no hubo errores.
+******************************************************************************/
+uint8_t os_uart_getErrors(os_Uart_t * port);
+
+#endif /* INC_MSE_OS_UART_H_ */
@@ -0,0 +1,60 @@
+/*
+ * main.c (M0APP)
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Imagen del co-procesador M0APP. Cada mensaje recibido del M4
+ *         se devuelve con el parámetro incrementado, como ejemplo de
+ *         tarea descargada en el M0APP
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_M0.h"
+#include "MSE_OS_IPC.h"
+
+/*==================[macros and definitions]=================================*/
+#define RX_TASK_PRIORITY		0
+#define RX_QUEUE_LENGTH			8
+
+/*==================[Static headers]=========================================*/
+
+static void rxTask(void);
+
+/*==================[Private data declaration]==============================*/
+
+static os_ipcMessage_t rxQueueStorage[RX_QUEUE_LENGTH];
+static os_m0_queue_t rxQueue;
+
+/******************************************************************************
+ *  @brief Tarea de recepción: atiende todos los mensajes de la cola.
+ *
+ *  @details
+ *   Si el ring hacia el M4 está lleno, el mensaje vuelve a atenderse en la
+ *   próxima ejecución de la tarea.
+ *
+ *  @return     none.
+******************************************************************************/
+static void rxTask(void)
+{
+	os_ipcMessage_t msg;
+
+	while (os_ipc_receive(&msg))
+	{
+		msg.param++;
+		while (!os_ipc_send(&msg));
+	}
+}
+
+int main(void)
+{
+	os_m0_queue_init(&rxQueue, rxQueueStorage, sizeof(os_ipcMessage_t),
+			RX_QUEUE_LENGTH, RX_TASK_PRIORITY);
+	os_m0_addTask(RX_TASK_PRIORITY, rxTask);
+
+	os_ipc_init(&rxQueue);
+
+	os_m0_run();
+
+	return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * startup.c (M0APP)
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Tabla de vectores y rutina de reset del co-procesador M0APP
+ *
+ *  El M4 mapea la imagen en la dirección 0 del M0APP (os_ipc_startM0), por
+ *  lo que la tabla de vectores va al comienzo de la imagen (m0app.ld).
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+
+/*==================[macros and definitions]=================================*/
+#define M0APP_IRQ_COUNT		32
+#define M0APP_M4_IRQ		1		/** M4_IRQn en el M0APP */
+
+/*==================[Static headers]=========================================*/
+
+void Reset_Handler(void);
+static void Default_Handler(void);
+
+void M4_IRQHandler(void);
+int main(void);
+
+/* Símbolos definidos en m0app.ld */
+extern uint32_t _stack_top;
+extern uint32_t _data_load, _data_start, _data_end;
+extern uint32_t _bss_start, _bss_end;
+
+/*==================[Private data declaration]==============================*/
+
+__attribute__((section(".isr_vector"), used))
+static void (* const vectors[16 + M0APP_IRQ_COUNT])(void) =
+{
+	[0] = (void (*)(void))&_stack_top,
+	[1] = Reset_Handler,
+	[2 ... 15] = Default_Handler,
+	[16 ... (16 + M0APP_IRQ_COUNT - 1)] = Default_Handler,
+	[16 + M0APP_M4_IRQ] = M4_IRQHandler,
+};
+
+/******************************************************************************
+ *  @brief Rutina de reset: inicializa .data y .bss y llama a main.
+ *
+ *  @return     none.
+******************************************************************************/
+void Reset_Handler(void)
+{
+	uint32_t * src = &_data_load;
+	uint32_t * dst = &_data_start;
+
+	while (dst < &_data_end)
+	{
+		*dst++ = *src++;
+	}
+
+	dst = &_bss_start;
+	while (dst < &_bss_end)
+	{
+		*dst++ = 0;
+	}
+
+	main();
+
+	while (1);
+}
+
+/******************************************************************************
+ *  @brief Handler de las excepciones e interrupciones no utilizadas.
+ *
+ *  @return     none.
+******************************************************************************/
+static void Default_Handler(void)
+{
+	while (1);
+}
@@ -13,6 +13,48 @@
 #include "MSE_OS_Core.h"
 #include <string.h>
 
+/*==================[macros and definitions]=================================*/
+
+/** El miembro 0 de un conjunto ocupa el bit más significativo (búsqueda con CLZ) */
+#define OS_QUEUESET_BIT(index)	(0x80000000UL >> (index))
+
+/** En una cola con prioridad cada elemento va precedido por su clave de orden:
+ *  la prioridad en los 8 bits altos y el número de secuencia en los 24 bajos */
+#define OS_QUEUE_KEY_SIZE				sizeof(uint32_t)
+#define OS_QUEUE_KEY(priority, seq)		(((uint32_t)(priority) << 24) | ((seq) & 0x00FFFFFF))
+#define OS_QUEUE_ENTRY(queue, i)		((queue)->data + (i) * (OS_QUEUE_KEY_SIZE + (queue)->elementSize))
+
+/*==================[Static headers]=========================================*/
+
+static bool os_delayUntilTick(uint32_t wakeTick);
+static void os_queue_insertElement(os_Queue_t * queue, void * data, uint8_t priority);
+static void os_queue_storeFifo(os_Queue_t * queue, void * data);
+static void os_queue_fetchFifo(os_Queue_t * queue, void * data);
+static void os_queue_storeHeap(os_Queue_t * queue, void * data, uint8_t priority);
+static void os_queue_fetchHeap(os_Queue_t * queue, void * data);
+static uint32_t os_queue_readKey(os_Queue_t * queue, uint16_t index);
+static bool os_queue_isBefore(uint32_t keyA, uint32_t keyB);
+static void os_queueset_notify(struct os_QueueSet * set, uint8_t index);
+static bool os_queueset_addMember(os_QueueSet_t * set, os_QueueSetMemberType_t type,
+		void * object, uint8_t * index);
+static void * os_queueset_findReady(os_QueueSet_t * set);
+static void os_stream_copyIn(os_StreamBuffer_t * sb, const uint8_t * src, uint16_t length);
+static void os_stream_peek(os_StreamBuffer_t * sb, uint8_t * dst, uint16_t length);
+static void os_stream_discard(os_StreamBuffer_t * sb, uint16_t length);
+static bool os_rwlock_isReadable(os_RwLock_t * lock);
+static void os_rwlock_wakeUp(os_RwLock_t * lock);
+
+/*==================[Private data declaration]==============================*/
+
+/** Colas inicializadas, enlazadas por nextRegistered */
+static os_Queue_t * os_queue_registry;
+
+/** Semáforos inicializados, enlazados por nextRegistered */
+static os_Semaphore_t * os_sem_registry;
+
+/** Locks de lectura/escritura inicializados, enlazados por nextRegistered */
+static os_RwLock_t * os_rwlock_registry;
+
 /******************************************************************************
  * Funciones públicas (descripción de las mimas en MSE_OS_API.h)
  *****************************************************************************/
@@ -46,12 +88,79 @@ void os_Delay(uint32_t ticks)
 
 		while (0 < actualTask->blockedTicks)
 		{
-			actualTask->state = os_task_state__blocked;
+			os_setTaskState(actualTask, os_task_state__blocked);
 			os_CpuYield();
 		}
 	}
 }
 
+bool os_DelayUntil(uint32_t * previousWake, uint32_t period)
+{
+	bool onTime;
+
+	if (os_control_state__running_from_IRQ == os_get_controlState())
+	{
+		os_setError(os_control_error_daly_from_IRQ, os_DelayUntil);
+	}
+
+	*previousWake += period;
+	onTime = os_delayUntilTick(*previousWake);
+
+	return (onTime);
+}
+
+void os_periodic_init(os_Periodic_t * periodic, uint32_t period)
+{
+	periodic->period = period;
+	periodic->lastRelease = os_get_systemClockMs();
+	periodic->activations = 0;
+	periodic->overruns = 0;
+	periodic->minJitterUs = 0xFFFFFFFF;
+	periodic->maxJitterUs = 0;
+	periodic->sumJitterUs = 0;
+}
+
+uint32_t os_periodic_wait(os_Periodic_t * periodic)
+{
+	uint32_t elapsed;
+	uint32_t missed = 0;
+	uint32_t jitterUs;
+
+	if (os_control_state__running_from_IRQ == os_get_controlState())
+	{
+		os_setError(os_control_error_daly_from_IRQ, os_periodic_wait);
+	}
+
+	/* Las activaciones que vencieron mientras la tarea seguía ejecutándose
+	 * se saltean, manteniendo la fase del período */
+	elapsed = os_get_systemClockMs() - periodic->lastRelease;
+	if (elapsed >= periodic->period)
+	{
+		missed = elapsed / periodic->period;
+		periodic->overruns += missed;
+	}
+	periodic->lastRelease += (missed + 1) * periodic->period;
+
+	os_delayUntilTick(periodic->lastRelease);
+
+	/* Aritmética de 32 bits: el producto conserva su valor módulo 2^32
+	 * aunque el contador de ticks haya dado la vuelta */
+	jitterUs = (uint32_t)os_get_systemClockUs() -
+			(periodic->lastRelease * os_get_tickPeriodUs());
+
+	periodic->activations++;
+	periodic->sumJitterUs += jitterUs;
+	if (jitterUs < periodic->minJitterUs)
+	{
+		periodic->minJitterUs = jitterUs;
+	}
+	if (jitterUs > periodic->maxJitterUs)
+	{
+		periodic->maxJitterUs = jitterUs;
+	}
+
+	return (missed);
+}
 
 /******************************************************************************
  *	Semaforos
@@ -59,16 +168,32 @@ void os_Delay(uint32_t ticks)
 
 void os_sem_init(os_Semaphore_t * sem)
 {
+	os_Semaphore_t * registered;
+
 	sem->taken = false;
 	sem->takenByTask = NULL;
+	sem->owner = NULL;
+	sem->set = NULL;
+
+	/* Un semáforo reinicializado ya figura en el registro */
+	os_enter_critical_zone();
+	registered = os_sem_registry;
+	while ((NULL != registered) && (sem != registered))
+	{
+		registered = registered->nextRegistered;
+	}
+	if (NULL == registered)
+	{
+		sem->nextRegistered = os_sem_registry;
+		os_sem_registry = sem;
+	}
+	os_exit_critical_zone();
 }
 
 void os_sem_take(os_Semaphore_t * sem)
 {
 	bool taken = false;
 
-	os_TaskHandler_t* actualTask;
-
 	while (!taken)
 	{
 		if (sem->taken)
@@ -76,9 +201,7 @@ void os_sem_take(os_Semaphore_t * sem)
 			/* esperar hasta que esté libre el semaforo*/
 
 			os_enter_critical_zone();
-			actualTask = os_getActualtask();
-			actualTask->state = os_task_state__blocked;
-			sem->takenByTask = actualTask;
+			os_blockActualTaskOn(&sem->takenByTask, OS_WAIT_FOREVER);
 			os_exit_critical_zone();
 
 			os_CpuYield();
@@ -86,7 +209,8 @@ void os_sem_take(os_Semaphore_t * sem)
 		else
 		{
 			sem->taken = true;
-			sem->takenByTask = actualTask;
+			sem->takenByTask = os_getActualtask();
+			sem->owner = sem->takenByTask;
 			taken = true;
 		}
 	}
@@ -94,115 +218,307 @@ void os_sem_take(os_Semaphore_t * sem)
 
 void os_sem_give(os_Semaphore_t * sem)
 {
-	if ((sem->taken) &&
-		(NULL != sem->takenByTask))
+	os_TaskHandler_t* waitingTask;
+
+	if (sem->taken)
 	{
+		os_enter_critical_zone();
 		sem->taken = false;
-		sem->takenByTask->state = os_task_state__ready;
+		waitingTask = sem->takenByTask;
+		sem->takenByTask = NULL;
+		sem->owner = NULL;
+		os_exit_critical_zone();
+
+		/* Solo se despierta a la tarea si realmente estaba esperando el semaforo.
+		 * Si es mas prioritaria que la actual, se ejecuta inmediatamente */
+		if ((NULL != waitingTask) &&
+			(os_task_state__blocked == waitingTask->state))
+		{
+			os_setTaskReady(waitingTask);
+		}
+
+		os_queueset_notify(sem->set, sem->setIndex);
+	}
+}
+
+void os_sem_releaseTask(os_TaskHandler_t * task)
+{
+	os_Semaphore_t * sem;
 
-		if (os_control_state__running_from_IRQ == os_get_controlState())
+	/* Los semáforos no se eliminan, por lo que el registro solo crece y
+	 * puede recorrerse fuera de la sección crítica */
+	for (sem = os_sem_registry; NULL != sem; sem = sem->nextRegistered)
+	{
+		if (sem->taken && (task == sem->owner))
 		{
-			os_setSchedulingFromIRQ();
+			os_sem_give(sem);
 		}
 	}
 }
 
 /******************************************************************************
- *	Colas
+ *	Locks de lectura/escritura
  ******************************************************************************/
-void os_queue_init(os_Queue_t * queue, uint16_t dataSize)
+void os_rwlock_init(os_RwLock_t * lock, bool writerPreference)
 {
-	queue->elementSize = dataSize;
-	queue->queueSize = 0;
-	queue->maxElements = OS_QUEUE_HEAP_SIZE / dataSize;
-	queue->taskWaitingForIt = NULL;
-	queue->headID = 0;
-	queue->tailID = 0;
-	memset(queue->data, OS_QUEUE_DEFAULT_VALUE,OS_QUEUE_HEAP_SIZE);
+	os_RwLock_t * registered;
+
+	lock->readers = 0;
+	lock->writer = NULL;
+	lock->writerPreference = writerPreference;
+	lock->readersWaiting = NULL;
+	lock->writersWaiting = NULL;
+
+	/* Un lock reinicializado ya figura en el registro */
+	os_enter_critical_zone();
+	registered = os_rwlock_registry;
+	while ((NULL != registered) && (lock != registered))
+	{
+		registered = registered->nextRegistered;
+	}
+	if (NULL == registered)
+	{
+		lock->nextRegistered = os_rwlock_registry;
+		os_rwlock_registry = lock;
+	}
+	os_exit_critical_zone();
 }
 
-void os_queue_insert(os_Queue_t * queue, void * data)
+bool os_rwlock_readLock(os_RwLock_t * lock, uint32_t timeout)
 {
-	os_TaskHandler_t* actualTask;
-
-	/** Se debe realizar los siguiente:
-	 *  1 - Verificar si la cola estaba vacia.
-	 *  2 - En caso de que estaba vacia verificar si había una tarea esperando por un elemento
-	 *  3 - Si había una tarea esperando por un elemento, verificar si su estado era blocked y
-	 *      pasarla a ready */
+	os_TaskHandler_t* actualTask = NULL;
+	bool acquired = false;
+	bool done = false;
 
-	if (0 == queue->queueSize)
+	/* Como con los semáforos, la tarea despertada vuelve a verificar si
+	 * puede tomar el lock */
+	while (!done)
 	{
-		if ((NULL != queue->taskWaitingForIt) &&
-				(os_task_state__blocked == queue->taskWaitingForIt->state))
+		os_enter_critical_zone();
+		if (os_rwlock_isReadable(lock))
 		{
-			queue->taskWaitingForIt->state = os_task_state__ready;
+			lock->readers++;
+			acquired = true;
+			done = true;
 		}
-
-		if (os_control_state__running_from_IRQ == os_get_controlState())
+		else if (OS_NO_WAIT == timeout)
+		{
+			done = true;
+		}
+		else
 		{
-			os_setSchedulingFromIRQ();
+			actualTask = os_blockActualTaskOnList(&lock->readersWaiting, timeout);
 		}
+		os_exit_critical_zone();
 
+		if (!done)
+		{
+			os_CpuYield();
+			timeout = os_getRemainingTimeout(&lock->readersWaiting, actualTask, timeout);
+		}
 	}
 
-	/*Si estoy corriendo desde un handler de interrupción y se quiere escribir en una cola
-	 * mientras esta está llena, no debe bloquearse y debe salir inmediatamente */
-	if ((os_control_state__running_from_IRQ == os_get_controlState()) &&
-			(queue->queueSize >= queue->maxElements))
-	{
+	return (acquired);
+}
 
-	}
-	else
+void os_rwlock_readUnlock(os_RwLock_t * lock)
+{
+	os_enter_critical_zone();
+	if (0 < lock->readers)
 	{
-		/* Mientras la cola esté llena, poner la tarea actual en estado bloqueado y
-		 * ceder el CPU */
-		while (queue->queueSize >= queue->maxElements)
+		lock->readers--;
+		if (0 == lock->readers)
 		{
-			os_enter_critical_zone();
-			actualTask = os_getActualtask();
-			actualTask->state = os_task_state__blocked;
-			queue->taskWaitingForIt = actualTask;
-			os_exit_critical_zone();
+			os_rwlock_wakeUp(lock);
+		}
+	}
+	os_exit_critical_zone();
+}
 
-			os_CpuYield();
+bool os_rwlock_writeLock(os_RwLock_t * lock, uint32_t timeout)
+{
+	os_TaskHandler_t* actualTask = NULL;
+	bool acquired = false;
+	bool done = false;
+
+	while (!done)
+	{
+		os_enter_critical_zone();
+		if ((NULL == lock->writer) && (0 == lock->readers))
+		{
+			lock->writer = os_getActualtask();
+			acquired = true;
+			done = true;
+		}
+		else if (OS_NO_WAIT == timeout)
+		{
+			/* Si era el único escritor en espera, los lectores que esperaban
+			 * por preferencia de escritura ya pueden entrar */
+			os_rwlock_wakeUp(lock);
+			done = true;
+		}
+		else
+		{
+			actualTask = os_blockActualTaskOnList(&lock->writersWaiting, timeout);
 		}
+		os_exit_critical_zone();
 
-		/* Realizar la inserción del elemento en la cola */
-		memcpy(queue->data + (queue->headID * queue->elementSize), data, queue->elementSize);
-		queue->headID++;
-		if (queue->headID >= queue->maxElements)
+		if (!done)
 		{
-			queue->headID = 0;
+			os_CpuYield();
+			timeout = os_getRemainingTimeout(&lock->writersWaiting, actualTask, timeout);
 		}
-		queue->queueSize++;
-		queue->taskWaitingForIt = NULL;
 	}
+
+	return (acquired);
 }
 
-void os_queue_remove(os_Queue_t * queue, void * data)
+void os_rwlock_writeUnlock(os_RwLock_t * lock)
 {
-	os_TaskHandler_t* actualTask;
+	os_enter_critical_zone();
+	if (os_getActualtask() == lock->writer)
+	{
+		lock->writer = NULL;
+		os_rwlock_wakeUp(lock);
+	}
+	os_exit_critical_zone();
+}
 
-	/** Se debe realizar los siguiente:
-	 *  1 - Verificar si la cola estaba llena.
-	 *  2 - En caso de que estaba llena verificar si había una tarea esperando por insertar un elemento
-	 *  3 - Si había una tarea esperando por insertar un elemento, verificar si su estado era blocked y
-	 *      pasarla a ready */
+void os_rwlock_releaseTask(os_TaskHandler_t * task)
+{
+	os_RwLock_t * lock;
 
-	if (queue->queueSize >= queue->maxElements)
+	/* Como el de semáforos, el registro solo crece */
+	for (lock = os_rwlock_registry; NULL != lock; lock = lock->nextRegistered)
 	{
-		if ((NULL != queue->taskWaitingForIt) &&
-				(os_task_state__blocked == queue->taskWaitingForIt->state))
+		os_enter_critical_zone();
+		if (task == lock->writer)
 		{
-			queue->taskWaitingForIt->state = os_task_state__ready;
+			lock->writer = NULL;
 		}
 
-		if (os_control_state__running_from_IRQ == os_get_controlState())
-		{
-			os_setSchedulingFromIRQ();
-		}
+		/* También si la tarea solo esperaba: os_detachWait la quitó de la
+		 * lista sin despertar a los lectores que esperaban por ella */
+		os_rwlock_wakeUp(lock);
+		os_exit_critical_zone();
 	}
+}
+
+/******************************************************************************
+ *	Variables de condición
+ ******************************************************************************/
+void os_cond_init(os_CondVar_t * cond)
+{
+	cond->waiting = NULL;
+}
+
+void os_cond_wait(os_CondVar_t * cond, os_Semaphore_t * mutex)
+{
+	os_cond_timedWait(cond, mutex, OS_WAIT_FOREVER);
+}
+
+bool os_cond_timedWait(os_CondVar_t * cond, os_Semaphore_t * mutex, uint32_t timeout)
+{
+	os_TaskHandler_t* actualTask;
+	bool signaled = false;
+
+	if (OS_NO_WAIT != timeout)
+	{
+		/* Liberar el semáforo y bloquearse en la misma sección crítica: una
+		 * señal posterior ya encuentra a la tarea en la lista de espera. El
+		 * semáforo se libera primero porque os_sem_give despertaría a la
+		 * tarea que lo tomó si la encontrara bloqueada */
+		os_enter_critical_zone();
+		os_sem_give(mutex);
+		actualTask = os_blockActualTaskOnList(&cond->waiting, timeout);
+		os_exit_critical_zone();
+
+		os_CpuYield();
+
+		/* Al expirar el timeout la tarea ya fue quitada de la lista */
+		signaled = (OS_NO_WAIT != os_getRemainingTimeout(&cond->waiting, actualTask, timeout));
+
+		os_sem_take(mutex);
+	}
+
+	return (signaled);
+}
+
+void os_cond_signal(os_CondVar_t * cond)
+{
+	os_enter_critical_zone();
+	os_wakeUpFirstWaitingTask(&cond->waiting);
+	os_exit_critical_zone();
+}
+
+void os_cond_broadcast(os_CondVar_t * cond)
+{
+	/* Las tareas despertadas no se ejecutan hasta haber despertado a todas */
+	os_enter_critical_zone();
+	while (NULL != os_wakeUpFirstWaitingTask(&cond->waiting));
+	os_exit_critical_zone();
+}
+
+/******************************************************************************
+ *	Colas
+ ******************************************************************************/
+void os_queue_init(os_Queue_t * queue, uint16_t dataSize)
+{
+	os_Queue_t * registered;
+
+	queue->elementSize = dataSize;
+	queue->queueSize = 0;
+	queue->maxElements = OS_QUEUE_HEAP_SIZE / dataSize;
+	queue->taskWaitingForIt = NULL;
+	queue->priorityMode = false;
+	queue->sequence = 0;
+	queue->headID = 0;
+	queue->tailID = 0;
+	queue->peakSize = 0;
+	queue->waitCount = 0;
+	memset(queue->data, OS_QUEUE_DEFAULT_VALUE,OS_QUEUE_HEAP_SIZE);
+
+	/* Una cola reinicializada ya figura en el registro y conserva su
+	 * conjunto, que sigue teniéndola como miembro (los pendientes del
+	 * conjunto solo indican que puede haber datos, por lo que no hace falta
+	 * limpiarlos). os_pubsub_subscribe inicializa colas en ejecución, por lo
+	 * que la búsqueda y la inserción se hacen en la sección crítica */
+	os_enter_critical_zone();
+	registered = os_queue_registry;
+	while ((NULL != registered) && (queue != registered))
+	{
+		registered = registered->nextRegistered;
+	}
+	if (NULL == registered)
+	{
+		queue->set = NULL;
+		queue->nextRegistered = os_queue_registry;
+		os_queue_registry = queue;
+	}
+	os_exit_critical_zone();
+}
+
+void os_queue_initPriority(os_Queue_t * queue, uint16_t dataSize)
+{
+	os_queue_init(queue, dataSize);
+	queue->priorityMode = true;
+	queue->maxElements = OS_QUEUE_HEAP_SIZE / (OS_QUEUE_KEY_SIZE + dataSize);
+}
+
+void os_queue_insert(os_Queue_t * queue, void * data)
+{
+	os_queue_insertElement(queue, data, OS_QUEUE_PRIORITY_LOWEST);
+}
+
+void os_queue_insertPriority(os_Queue_t * queue, void * data, uint8_t priority)
+{
+	os_queue_insertElement(queue, data, priority);
+}
+
+void os_queue_remove(os_Queue_t * queue, void * data)
+{
+	bool wasFull;
+	bool blocked;
 
 	/*Si estoy corriendo desde un handler de interrupción y se quiere leer de una cola
 	 * mientras esta está vacía, no debe bloquearse y debe salir inmediatamente */
@@ -217,24 +533,987 @@ void os_queue_remove(os_Queue_t * queue, void * data)
 		 * ceder el CPU */
 		while (0 == queue->queueSize)
 		{
+			/* La condición se vuelve a evaluar dentro de la sección crítica: una
+			 * interrupción que la cambió desde la evaluación del while no vio a
+			 * la tarea en espera y no la despertaría */
 			os_enter_critical_zone();
-			actualTask = os_getActualtask();
-			actualTask->state = os_task_state__blocked;
-			queue->taskWaitingForIt = actualTask;
+			blocked = (0 == queue->queueSize);
+			if (blocked)
+			{
+				os_blockActualTaskOn(&queue->taskWaitingForIt, OS_WAIT_FOREVER);
+				queue->waitCount++;
+			}
 			os_exit_critical_zone();
 
-			os_CpuYield();
+			if (blocked)
+			{
+				os_CpuYield();
+			}
 		}
 
 		/* Realizar la remoción del elemento en la cola */
-		memcpy(data, queue->data + (queue->tailID * queue->elementSize), queue->elementSize);
-		queue->tailID++;
-		if (queue->tailID >= queue->maxElements)
+		os_enter_critical_zone();
+		wasFull = (queue->queueSize >= queue->maxElements);
+		if (queue->priorityMode)
+		{
+			os_queue_fetchHeap(queue, data);
+		}
+		else
 		{
-			queue->tailID = 0;
+			os_queue_fetchFifo(queue, data);
 		}
 		queue->queueSize--;
-		queue->taskWaitingForIt = NULL;
+		os_exit_critical_zone();
+
+		/** Recién con el elemento ya removido:
+		 *  1 - Verificar si la cola estaba llena.
+		 *  2 - En caso de que estaba llena verificar si había una tarea esperando por insertar un elemento
+		 *  3 - Si había una tarea esperando por insertar un elemento, pasarla a ready (si es más
+		 *      prioritaria que la actual se ejecuta inmediatamente) */
+		if (wasFull)
+		{
+			os_wakeUpWaitingTask(&queue->taskWaitingForIt);
+		}
+	}
+}
+
+os_Queue_t * os_queue_getNext(os_Queue_t * queue)
+{
+	return ((NULL == queue) ? os_queue_registry : queue->nextRegistered);
+}
+
+void os_queue_resetStats(os_Queue_t * queue)
+{
+	os_enter_critical_zone();
+	queue->peakSize = queue->queueSize;
+	queue->waitCount = 0;
+	os_exit_critical_zone();
+}
+
+/******************************************************************************
+ *	Conjuntos de colas y semáforos
+ ******************************************************************************/
+void os_queueset_init(os_QueueSet_t * set)
+{
+	set->numberOfMembers = 0;
+	set->pendingMask = 0;
+	set->taskWaiting = NULL;
+}
+
+bool os_queueset_addQueue(os_QueueSet_t * set, os_Queue_t * queue)
+{
+	bool result = false;
+
+	if (NULL == queue->set)
+	{
+		result = os_queueset_addMember(set, os_queueset_member__queue, queue, &queue->setIndex);
+		if (result)
+		{
+			queue->set = set;
+		}
+	}
+
+	return result;
+}
+
+bool os_queueset_addSemaphore(os_QueueSet_t * set, os_Semaphore_t * sem)
+{
+	bool result = false;
+
+	if (NULL == sem->set)
+	{
+		result = os_queueset_addMember(set, os_queueset_member__semaphore, sem, &sem->setIndex);
+		if (result)
+		{
+			sem->set = set;
+		}
+	}
+
+	return result;
+}
+
+void * os_queueset_select(os_QueueSet_t * set, uint32_t timeout)
+{
+	os_TaskHandler_t* actualTask = NULL;
+	void * object = NULL;
+	bool done = false;
+
+	/* Desde una interrupción nunca se bloquea */
+	if (os_control_state__running_from_IRQ == os_get_controlState())
+	{
+		timeout = OS_NO_WAIT;
+	}
+
+	while (!done)
+	{
+		os_enter_critical_zone();
+		object = os_queueset_findReady(set);
+		if ((NULL != object) || (OS_NO_WAIT == timeout))
+		{
+			done = true;
+		}
+		else
+		{
+			actualTask = os_blockActualTaskOn(&set->taskWaiting, timeout);
+		}
+		os_exit_critical_zone();
+
+		if (!done)
+		{
+			os_CpuYield();
+			timeout = os_getRemainingTimeout(&set->taskWaiting, actualTask, timeout);
+		}
 	}
+
+	return (object);
 }
 
+/******************************************************************************
+ *	Stream y message buffers
+ ******************************************************************************/
+void os_stream_init(os_StreamBuffer_t * sb, uint16_t triggerLevel)
+{
+	sb->headID = 0;
+	sb->tailID = 0;
+	sb->usedBytes = 0;
+	sb->isMessageBuffer = false;
+	sb->readerWaiting = NULL;
+	sb->writerWaiting = NULL;
+
+	/* Un trigger level fuera de rango haría que el lector no se despierte nunca */
+	if (0 == triggerLevel)
+	{
+		triggerLevel = 1;
+	}
+	else if (triggerLevel > OS_STREAM_BUFFER_SIZE)
+	{
+		triggerLevel = OS_STREAM_BUFFER_SIZE;
+	}
+	sb->triggerLevel = triggerLevel;
+}
+
+uint16_t os_stream_send(os_StreamBuffer_t * sb, const void * data,
+		uint16_t length, uint32_t timeout)
+{
+	os_TaskHandler_t* actualTask = NULL;
+	uint16_t written = 0;
+	uint16_t chunk;
+	bool wakeUpReader = false;
+	bool done = sb->isMessageBuffer;	/* un message buffer no acepta bytes sueltos */
+
+	/* Desde una interrupción nunca se bloquea */
+	if (os_control_state__running_from_IRQ == os_get_controlState())
+	{
+		timeout = OS_NO_WAIT;
+	}
+
+	while ((written < length) && !done)
+	{
+		os_enter_critical_zone();
+		chunk = OS_STREAM_BUFFER_SIZE - sb->usedBytes;
+		if (chunk > (length - written))
+		{
+			chunk = length - written;
+		}
+
+		if (0 < chunk)
+		{
+			os_stream_copyIn(sb, (const uint8_t *)data + written, chunk);
+			written += chunk;
+			wakeUpReader = (sb->usedBytes >= sb->triggerLevel);
+		}
+		else if (OS_NO_WAIT == timeout)
+		{
+			done = true;
+		}
+		else
+		{
+			actualTask = os_blockActualTaskOn(&sb->writerWaiting, timeout);
+		}
+		os_exit_critical_zone();
+
+		if (0 < chunk)
+		{
+			if (wakeUpReader)
+			{
+				os_wakeUpWaitingTask(&sb->readerWaiting);
+			}
+		}
+		else if (!done)
+		{
+			os_CpuYield();
+			timeout = os_getRemainingTimeout(&sb->writerWaiting, actualTask, timeout);
+		}
+	}
+
+	return (written);
+}
+
+uint16_t os_stream_receive(os_StreamBuffer_t * sb, void * data,
+		uint16_t maxLength, uint32_t timeout)
+{
+	os_TaskHandler_t* actualTask = NULL;
+	uint16_t read = 0;
+	bool done = sb->isMessageBuffer;	/* un message buffer no entrega bytes sueltos */
+
+	/* Desde una interrupción nunca se bloquea */
+	if (os_control_state__running_from_IRQ == os_get_controlState())
+	{
+		timeout = OS_NO_WAIT;
+	}
+
+	while (!done)
+	{
+		os_enter_critical_zone();
+		/* Al expirar el timeout se entregan los bytes disponibles aunque no
+		 * alcancen el trigger level */
+		if ((sb->usedBytes >= sb->triggerLevel) || (OS_NO_WAIT == timeout))
+		{
+			read = (sb->usedBytes < maxLength) ? sb->usedBytes : maxLength;
+			os_stream_peek(sb, data, read);
+			os_stream_discard(sb, read);
+			done = true;
+		}
+		else
+		{
+			actualTask = os_blockActualTaskOn(&sb->readerWaiting, timeout);
+		}
+		os_exit_critical_zone();
+
+		if (!done)
+		{
+			os_CpuYield();
+			timeout = os_getRemainingTimeout(&sb->readerWaiting, actualTask, timeout);
+		}
+	}
+
+	if (0 < read)
+	{
+		os_wakeUpWaitingTask(&sb->writerWaiting);
+	}
+
+	return (read);
+}
+
+void os_message_init(os_StreamBuffer_t * sb)
+{
+	os_stream_init(sb, 1);
+	sb->isMessageBuffer = true;
+}
+
+bool os_message_send(os_StreamBuffer_t * sb, const void * data,
+		uint16_t length, uint32_t timeout)
+{
+	os_TaskHandler_t* actualTask = NULL;
+	os_messageLength_t header = length;
+	uint32_t needed = (uint32_t)length + sizeof(os_messageLength_t);
+	bool sent = false;
+	bool done = (!sb->isMessageBuffer) ||
+				(0 == length) ||	/* se recibiría como "ningún mensaje" */
+				(needed > OS_STREAM_BUFFER_SIZE);	/* nunca entraría en el buffer */
+
+	/* Desde una interrupción nunca se bloquea */
+	if (os_control_state__running_from_IRQ == os_get_controlState())
+	{
+		timeout = OS_NO_WAIT;
+	}
+
+	while (!done)
+	{
+		os_enter_critical_zone();
+		if ((uint32_t)(OS_STREAM_BUFFER_SIZE - sb->usedBytes) >= needed)
+		{
+			os_stream_copyIn(sb, (const uint8_t *)&header, sizeof(os_messageLength_t));
+			os_stream_copyIn(sb, data, length);
+			sent = true;
+			done = true;
+		}
+		else if (OS_NO_WAIT == timeout)
+		{
+			done = true;
+		}
+		else
+		{
+			actualTask = os_blockActualTaskOn(&sb->writerWaiting, timeout);
+		}
+		os_exit_critical_zone();
+
+		if (!done)
+		{
+			os_CpuYield();
+			timeout = os_getRemainingTimeout(&sb->writerWaiting, actualTask, timeout);
+		}
+	}
+
+	if (sent)
+	{
+		os_wakeUpWaitingTask(&sb->readerWaiting);
+	}
+
+	return (sent);
+}
+
+uint16_t os_message_receive(os_StreamBuffer_t * sb, void * data,
+		uint16_t maxLength, uint32_t timeout)
+{
+	os_TaskHandler_t* actualTask = NULL;
+	os_messageLength_t header;
+	uint16_t read = 0;
+	bool done = !sb->isMessageBuffer;
+
+	/* Desde una interrupción nunca se bloquea */
+	if (os_control_state__running_from_IRQ == os_get_controlState())
+	{
+		timeout = OS_NO_WAIT;
+	}
+
+	while (!done)
+	{
+		os_enter_critical_zone();
+		if (0 < sb->usedBytes)
+		{
+			os_stream_peek(sb, (uint8_t *)&header, sizeof(os_messageLength_t));
+
+			/* Si el mensaje no entra en el destino, queda en el buffer */
+			if (header <= maxLength)
+			{
+				os_stream_discard(sb, sizeof(os_messageLength_t));
+				os_stream_peek(sb, data, header);
+				os_stream_discard(sb, header);
+				read = header;
+			}
+			done = true;
+		}
+		else if (OS_NO_WAIT == timeout)
+		{
+			done = true;
+		}
+		else
+		{
+			actualTask = os_blockActualTaskOn(&sb->readerWaiting, timeout);
+		}
+		os_exit_critical_zone();
+
+		if (!done)
+		{
+			os_CpuYield();
+			timeout = os_getRemainingTimeout(&sb->readerWaiting, actualTask, timeout);
+		}
+	}
+
+	if (0 < read)
+	{
+		os_wakeUpWaitingTask(&sb->writerWaiting);
+	}
+
+	return (read);
+}
+
+uint16_t os_message_nextLength(os_StreamBuffer_t * sb)
+{
+	os_messageLength_t header = 0;
+
+	os_enter_critical_zone();
+	if (sb->isMessageBuffer && (0 < sb->usedBytes))
+	{
+		os_stream_peek(sb, (uint8_t *)&header, sizeof(os_messageLength_t));
+	}
+	os_exit_critical_zone();
+
+	return (header);
+}
+
+/******************************************************************************
+ *	Doble buffer
+ ******************************************************************************/
+void os_pingpong_init(os_PingPong_t * pp, void * block0, void * block1)
+{
+	pp->blocks[0] = block0;
+	pp->blocks[1] = block1;
+	pp->writeBlock = 0;
+	pp->readyBlock = OS_PINGPONG_NONE;
+	pp->heldBlock = OS_PINGPONG_NONE;
+	pp->overruns = 0;
+	pp->readerWaiting = NULL;
+}
+
+void * os_pingpong_blockFilled(os_PingPong_t * pp)
+{
+	void * nextBlock;
+
+	os_enter_critical_zone();
+	pp->writeBlock ^= 1;
+
+	/* El productor va a sobrescribir el otro bloque: si la tarea todavía lo
+	 * tiene, o ni siquiera lo recibió, su contenido se pierde */
+	if ((pp->readyBlock == pp->writeBlock) || (pp->heldBlock == pp->writeBlock))
+	{
+		pp->overruns++;
+	}
+	pp->readyBlock = pp->writeBlock ^ 1;
+	nextBlock = pp->blocks[pp->writeBlock];
+	os_exit_critical_zone();
+
+	os_wakeUpWaitingTask(&pp->readerWaiting);
+
+	return (nextBlock);
+}
+
+void * os_pingpong_receive(os_PingPong_t * pp, uint32_t timeout)
+{
+	os_TaskHandler_t* actualTask = NULL;
+	void * block = NULL;
+	bool done = false;
+
+	/* Desde una interrupción nunca se bloquea */
+	if (os_control_state__running_from_IRQ == os_get_controlState())
+	{
+		timeout = OS_NO_WAIT;
+	}
+
+	while (!done)
+	{
+		os_enter_critical_zone();
+		if (OS_PINGPONG_NONE != pp->readyBlock)
+		{
+			pp->heldBlock = pp->readyBlock;
+			pp->readyBlock = OS_PINGPONG_NONE;
+			block = pp->blocks[pp->heldBlock];
+			done = true;
+		}
+		else if (OS_NO_WAIT == timeout)
+		{
+			done = true;
+		}
+		else
+		{
+			actualTask = os_blockActualTaskOn(&pp->readerWaiting, timeout);
+		}
+		os_exit_critical_zone();
+
+		if (!done)
+		{
+			os_CpuYield();
+			timeout = os_getRemainingTimeout(&pp->readerWaiting, actualTask, timeout);
+		}
+	}
+
+	return (block);
+}
+
+void os_pingpong_release(os_PingPong_t * pp)
+{
+	pp->heldBlock = OS_PINGPONG_NONE;
+}
+
+/******************************************************************************
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief Bloquea a la tarea actual hasta un tick absoluto
+ *
+ *  @details
+ *   Los ticks restantes se calculan y la tarea se bloquea dentro de la misma
+ *   sección crítica, para que un tick intermedio no retrase la activación.
+ *
+ *  @param wakeTick				tick en el que debe despertar la tarea
+ *  @return     false si el tick ya había pasado.
+******************************************************************************/
+static bool os_delayUntilTick(uint32_t wakeTick)
+{
+	os_TaskHandler_t* actualTask = NULL;
+	uint32_t remaining;
+	bool onTime;
+
+	os_enter_critical_zone();
+	remaining = wakeTick - os_get_systemClockMs();
+	onTime = (0 < (int32_t)remaining);
+	if (onTime)
+	{
+		actualTask = os_blockActualTask(remaining);
+	}
+	os_exit_critical_zone();
+
+	if (onTime)
+	{
+		os_CpuYield();
+
+		/* Igual que en os_Delay, la tarea solo continúa al agotar sus ticks */
+		while (0 < actualTask->blockedTicks)
+		{
+			os_setTaskState(actualTask, os_task_state__blocked);
+			os_CpuYield();
+		}
+	}
+
+	return (onTime);
+}
+
+/******************************************************************************
+ *  @brief Inserción de un elemento en una cola
+ *
+ *  @details
+ *   Implementación común de os_queue_insert y os_queue_insertPriority.
+ *
+ *  @param *queue				puntero a la cola
+ *  @param *data				elemento a insertar
+ *  @param priority				prioridad del elemento (solo en colas con prioridad)
+ *  @return     none.
+******************************************************************************/
+static void os_queue_insertElement(os_Queue_t * queue, void * data, uint8_t priority)
+{
+	bool wasEmpty;
+	bool blocked;
+
+	/*Si estoy corriendo desde un handler de interrupción y se quiere escribir en una cola
+	 * mientras esta está llena, no debe bloquearse y debe salir inmediatamente */
+	if ((os_control_state__running_from_IRQ == os_get_controlState()) &&
+			(queue->queueSize >= queue->maxElements))
+	{
+
+	}
+	else
+	{
+		/* Mientras la cola esté llena, poner la tarea actual en estado bloqueado y
+		 * ceder el CPU */
+		while (queue->queueSize >= queue->maxElements)
+		{
+			/* La condición se vuelve a evaluar dentro de la sección crítica: una
+			 * interrupción que la cambió desde la evaluación del while no vio a
+			 * la tarea en espera y no la despertaría */
+			os_enter_critical_zone();
+			blocked = (queue->queueSize >= queue->maxElements);
+			if (blocked)
+			{
+				os_blockActualTaskOn(&queue->taskWaitingForIt, OS_WAIT_FOREVER);
+				queue->waitCount++;
+			}
+			os_exit_critical_zone();
+
+			if (blocked)
+			{
+				os_CpuYield();
+			}
+		}
+
+		/* Realizar la inserción del elemento en la cola */
+		os_enter_critical_zone();
+		wasEmpty = (0 == queue->queueSize);
+		if (queue->priorityMode)
+		{
+			os_queue_storeHeap(queue, data, priority);
+		}
+		else
+		{
+			os_queue_storeFifo(queue, data);
+		}
+		queue->queueSize++;
+		if (queue->queueSize > queue->peakSize)
+		{
+			queue->peakSize = queue->queueSize;
+		}
+		os_exit_critical_zone();
+
+		/** Recién con el elemento ya insertado:
+		 *  1 - Verificar si la cola estaba vacia.
+		 *  2 - En caso de que estaba vacia verificar si había una tarea esperando por un elemento
+		 *  3 - Si había una tarea esperando por un elemento, pasarla a ready (si es más
+		 *      prioritaria que la actual se ejecuta inmediatamente) */
+		if (wasEmpty)
+		{
+			os_wakeUpWaitingTask(&queue->taskWaitingForIt);
+			os_queueset_notify(queue->set, queue->setIndex);
+		}
+	}
+}
+
+
+/******************************************************************************
+ *  @brief Guarda un elemento al final de una cola FIFO
+ *
+ *  @details
+ *   El llamador debe verificar que haya espacio y estar en sección crítica.
+ *
+ *  @param *queue				puntero a la cola
+ *  @param *data				elemento a guardar
+ *  @return     none.
+******************************************************************************/
+static void os_queue_storeFifo(os_Queue_t * queue, void * data)
+{
+	memcpy(queue->data + (queue->headID * queue->elementSize), data, queue->elementSize);
+	queue->headID++;
+	if (queue->headID >= queue->maxElements)
+	{
+		queue->headID = 0;
+	}
+}
+
+/******************************************************************************
+ *  @brief Extrae el elemento más antiguo de una cola FIFO
+ *
+ *  @details
+ *   El llamador debe verificar que la cola no esté vacía y estar en
+ *   sección crítica.
+ *
+ *  @param *queue				puntero a la cola
+ *  @param *data				elemento extraído
+ *  @return     none.
+******************************************************************************/
+static void os_queue_fetchFifo(os_Queue_t * queue, void * data)
+{
+	memcpy(data, queue->data + (queue->tailID * queue->elementSize), queue->elementSize);
+	queue->tailID++;
+	if (queue->tailID >= queue->maxElements)
+	{
+		queue->tailID = 0;
+	}
+}
+
+/******************************************************************************
+ *  @brief Guarda un elemento en el heap de una cola con prioridad
+ *
+ *  @details
+ *   El lugar libre se ubica al final del heap y sube mientras su padre deba
+ *   salir después que el nuevo elemento: cada padre se mueve una sola vez
+ *   y el elemento se escribe directamente en su posición final. El llamador
+ *   debe verificar que haya espacio y estar en sección crítica.
+ *
+ *  @param *queue				puntero a la cola
+ *  @param *data				elemento a guardar
+ *  @param priority				prioridad del elemento
+ *  @return     none.
+******************************************************************************/
+static void os_queue_storeHeap(os_Queue_t * queue, void * data, uint8_t priority)
+{
+	const uint16_t entrySize = OS_QUEUE_KEY_SIZE + queue->elementSize;
+	uint32_t key = OS_QUEUE_KEY(priority, queue->sequence);
+	uint16_t hole = queue->queueSize;
+	uint16_t parent;
+	bool placed = false;
+
+	queue->sequence++;
+
+	while ((0 < hole) && !placed)
+	{
+		parent = (hole - 1) / 2;
+		if (os_queue_isBefore(key, os_queue_readKey(queue, parent)))
+		{
+			memcpy(OS_QUEUE_ENTRY(queue, hole), OS_QUEUE_ENTRY(queue, parent), entrySize);
+			hole = parent;
+		}
+		else
+		{
+			placed = true;
+		}
+	}
+
+	memcpy(OS_QUEUE_ENTRY(queue, hole), &key, OS_QUEUE_KEY_SIZE);
+	memcpy(OS_QUEUE_ENTRY(queue, hole) + OS_QUEUE_KEY_SIZE, data, queue->elementSize);
+}
+
+/******************************************************************************
+ *  @brief Extrae el elemento de mayor prioridad de una cola con prioridad
+ *
+ *  @details
+ *   El último elemento del heap ocupa el lugar de la raíz y baja mientras
+ *   alguno de sus hijos deba salir antes. Como el último elemento queda
+ *   fuera del heap achicado, se lee desde su posición original y solo se
+ *   escribe al final. El llamador debe verificar que la cola no esté vacía
+ *   y estar en sección crítica.
+ *
+ *  @param *queue				puntero a la cola
+ *  @param *data				elemento extraído
+ *  @return     none.
+******************************************************************************/
+static void os_queue_fetchHeap(os_Queue_t * queue, void * data)
+{
+	const uint16_t entrySize = OS_QUEUE_KEY_SIZE + queue->elementSize;
+	const uint16_t last = queue->queueSize - 1;
+	uint32_t lastKey = os_queue_readKey(queue, last);
+	uint16_t hole = 0;
+	uint16_t child;
+	bool placed = false;
+
+	memcpy(data, OS_QUEUE_ENTRY(queue, 0) + OS_QUEUE_KEY_SIZE, queue->elementSize);
+
+	while (!placed)
+	{
+		child = 2 * hole + 1;
+		if ((child + 1 < last) &&
+				os_queue_isBefore(os_queue_readKey(queue, child + 1), os_queue_readKey(queue, child)))
+		{
+			child++;
+		}
+
+		if ((child < last) && os_queue_isBefore(os_queue_readKey(queue, child), lastKey))
+		{
+			memcpy(OS_QUEUE_ENTRY(queue, hole), OS_QUEUE_ENTRY(queue, child), entrySize);
+			hole = child;
+		}
+		else
+		{
+			placed = true;
+		}
+	}
+
+	if (hole != last)
+	{
+		memcpy(OS_QUEUE_ENTRY(queue, hole), OS_QUEUE_ENTRY(queue, last), entrySize);
+	}
+}
+
+/******************************************************************************
+ *  @brief Lee la clave de orden de un elemento del heap
+ *
+ *  @param *queue				puntero a la cola
+ *  @param index				posición en el heap
+ *  @return     clave del elemento.
+******************************************************************************/
+static uint32_t os_queue_readKey(os_Queue_t * queue, uint16_t index)
+{
+	uint32_t key;
+
+	memcpy(&key, OS_QUEUE_ENTRY(queue, index), OS_QUEUE_KEY_SIZE);
+
+	return (key);
+}
+
+/******************************************************************************
+ *  @brief Indica si un elemento debe salir antes que otro
+ *
+ *  @details
+ *   Primero decide la prioridad. A igual prioridad, el número de secuencia
+ *   se compara por diferencia para tolerar que dé la vuelta.
+ *
+ *  @param keyA					clave del primer elemento
+ *  @param keyB					clave del segundo elemento
+ *  @return     true si el primer elemento sale antes.
+******************************************************************************/
+static bool os_queue_isBefore(uint32_t keyA, uint32_t keyB)
+{
+	bool result;
+
+	if ((keyA >> 24) != (keyB >> 24))
+	{
+		result = ((keyA >> 24) < (keyB >> 24));
+	}
+	else
+	{
+		result = ((int32_t)((keyA - keyB) << 8) < 0);
+	}
+
+	return (result);
+}
+
+/******************************************************************************
+ *  @brief Notifica a un conjunto que uno de sus objetos puede estar listo
+ *
+ *  @details
+ *   Se llama cuando una cola deja de estar vacía o se libera un semáforo.
+ *   Solo marca al objeto como pendiente; os_queueset_select verifica luego
+ *   si realmente está listo.
+ *
+ *  @param *set					conjunto del objeto, o NULL si no pertenece a uno
+ *  @param index				índice del objeto dentro del conjunto
+ *  @return     none.
+******************************************************************************/
+static void os_queueset_notify(struct os_QueueSet * set, uint8_t index)
+{
+	if (NULL != set)
+	{
+		os_enter_critical_zone();
+		set->pendingMask |= OS_QUEUESET_BIT(index);
+		os_exit_critical_zone();
+
+		os_wakeUpWaitingTask(&set->taskWaiting);
+	}
+}
+
+/******************************************************************************
+ *  @brief Agrega un objeto a un conjunto
+ *
+ *  @details
+ *   Si el objeto ya está listo queda marcado como pendiente.
+ *
+ *  @param *set					puntero al conjunto
+ *  @param type					tipo del objeto
+ *  @param *object				cola o semáforo
+ *  @param *index				índice asignado al objeto
+ *  @return     true si había lugar en el conjunto.
+******************************************************************************/
+static bool os_queueset_addMember(os_QueueSet_t * set, os_QueueSetMemberType_t type,
+		void * object, uint8_t * index)
+{
+	bool result = false;
+
+	os_enter_critical_zone();
+	if (set->numberOfMembers < OS_QUEUESET_MAX_MEMBERS)
+	{
+		*index = set->numberOfMembers;
+		set->members[*index].type = type;
+		set->members[*index].object = object;
+		set->numberOfMembers++;
+		set->pendingMask |= OS_QUEUESET_BIT(*index);
+		result = true;
+	}
+	os_exit_critical_zone();
+
+	return result;
+}
+
+/******************************************************************************
+ *  @brief Busca el primer objeto listo de un conjunto
+ *
+ *  @details
+ *   Recorre solo los objetos pendientes. Los que ya no están listos dejan
+ *   de estar pendientes hasta la próxima notificación; los que están listos
+ *   siguen pendientes, ya que pueden tener más de un elemento. Debe
+ *   llamarse dentro de una sección crítica.
+ *
+ *  @param *set					puntero al conjunto
+ *  @return     objeto listo, NULL si no hay ninguno.
+******************************************************************************/
+static void * os_queueset_findReady(os_QueueSet_t * set)
+{
+	os_QueueSetMember_t * member;
+	uint32_t pending = set->pendingMask;
+	uint32_t bit;
+	uint8_t index;
+	void * object = NULL;
+	bool ready;
+
+	while ((0 != pending) && (NULL == object))
+	{
+		index = __CLZ(pending);
+		member = &set->members[index];
+		bit = OS_QUEUESET_BIT(index);
+		pending &= ~bit;
+
+		if (os_queueset_member__queue == member->type)
+		{
+			ready = (0 < ((os_Queue_t *)member->object)->queueSize);
+		}
+		else
+		{
+			ready = !((os_Semaphore_t *)member->object)->taken;
+		}
+
+		if (ready)
+		{
+			object = member->object;
+		}
+		else
+		{
+			set->pendingMask &= ~bit;
+		}
+	}
+
+	return (object);
+}
+
+/******************************************************************************
+ *  @brief Copia bytes al ring de un stream buffer
+ *
+ *  @details
+ *   El llamador debe verificar que haya espacio y estar en sección crítica.
+ *
+ *  @param *sb					puntero al stream buffer
+ *  @param *src					bytes a copiar
+ *  @param length				cantidad de bytes
+ *  @return     none.
+******************************************************************************/
+static void os_stream_copyIn(os_StreamBuffer_t * sb, const uint8_t * src, uint16_t length)
+{
+	uint16_t firstChunk = OS_STREAM_BUFFER_SIZE - sb->headID;
+
+	if (firstChunk > length)
+	{
+		firstChunk = length;
+	}
+
+	memcpy(&sb->data[sb->headID], src, firstChunk);
+	memcpy(sb->data, src + firstChunk, length - firstChunk);
+
+	sb->headID = ((uint32_t)sb->headID + length) % OS_STREAM_BUFFER_SIZE;
+	sb->usedBytes += length;
+}
+
+/******************************************************************************
+ *  @brief Copia bytes del ring de un stream buffer sin consumirlos
+ *
+ *  @details
+ *   El llamador debe verificar que haya suficientes bytes y estar en
+ *   sección crítica.
+ *
+ *  @param *sb					puntero al stream buffer
+ *  @param *dst					destino de los bytes
+ *  @param length				cantidad de bytes
+ *  @return     none.
+******************************************************************************/
+static void os_stream_peek(os_StreamBuffer_t * sb, uint8_t * dst, uint16_t length)
+{
+	uint16_t firstChunk = OS_STREAM_BUFFER_SIZE - sb->tailID;
+
+	if (firstChunk > length)
+	{
+		firstChunk = length;
+	}
+
+	memcpy(dst, &sb->data[sb->tailID], firstChunk);
+	memcpy(dst + firstChunk, sb->data, length - firstChunk);
+}
+
+/******************************************************************************
+ *  @brief Descarta bytes del ring de un stream buffer
+ *
+ *  @param *sb					puntero al stream buffer
+ *  @param length				cantidad de bytes
+ *  @return     none.
+******************************************************************************/
+static void os_stream_discard(os_StreamBuffer_t * sb, uint16_t length)
+{
+	sb->tailID = ((uint32_t)sb->tailID + length) % OS_STREAM_BUFFER_SIZE;
+	sb->usedBytes -= length;
+}
+
+/******************************************************************************
+ *  @brief Indica si un lector puede tomar un lock de lectura/escritura
+ *
+ *  @param *lock				puntero al lock
+ *  @return     true si no hay escritor ni, con preferencia de escritura,
+ *  			escritores en espera.
+******************************************************************************/
+static bool os_rwlock_isReadable(os_RwLock_t * lock)
+{
+	return ((NULL == lock->writer) &&
+			!(lock->writerPreference && (NULL != lock->writersWaiting)));
+}
+
+/******************************************************************************
+ *  @brief Despierta a las tareas que pueden tomar un lock de lectura/escritura
+ *
+ *  @details
+ *   Con el lock libre se despierta al escritor más prioritario, salvo que
+ *   sin preferencia de escritura haya lectores esperando. Si los lectores
+ *   pueden entrar se los despierta a todos. Las tareas despertadas vuelven
+ *   a verificar el lock, por orden de prioridad. Debe llamarse dentro de
+ *   una sección crítica, para que ninguna tarea despertada desaloje a la
+ *   actual antes de despertar a las demás.
+ *
+ *  @param *lock				puntero al lock
+ *  @return     none.
+******************************************************************************/
+static void os_rwlock_wakeUp(os_RwLock_t * lock)
+{
+	if ((NULL == lock->writer) && (0 == lock->readers) &&
+		(NULL != lock->writersWaiting) &&
+		(lock->writerPreference || (NULL == lock->readersWaiting)))
+	{
+		os_wakeUpFirstWaitingTask(&lock->writersWaiting);
+	}
+	else if (os_rwlock_isReadable(lock))
+	{
+		while (NULL != os_wakeUpFirstWaitingTask(&lock->readersWaiting));
+	}
+}
@@ -0,0 +1,135 @@
+/*
+ * MSE_OS_Adc.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Adquisición continua del ADC por bloques mediante GPDMA
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_Adc.h"
+#include "MSE_OS_DMA.h"
+#include "MSE_OS_DSP.h"
+
+/*==================[macros and definitions]=================================*/
+typedef struct
+{
+	LPC_ADC_T * adc;
+	uint32_t connection;
+} os_adc_hw_t;
+
+/*==================[Static headers]=========================================*/
+
+static void os_adc_dmaCallback(uint8_t channel, bool error, void * param);
+
+/*==================[Private data declaration]==============================*/
+
+static const os_adc_hw_t os_adc_hw[os_adc_count] =
+{
+	{LPC_ADC0, GPDMA_CONN_ADC_0},
+	{LPC_ADC1, GPDMA_CONN_ADC_1},
+};
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_Adc.h)
+ *****************************************************************************/
+bool os_adc_startStream(os_AdcStream_t * stream, os_adc_id_t id,
+		ADC_CHANNEL_T channel, uint32_t sampleRate)
+{
+	const os_adc_hw_t * hw;
+	ADC_CLOCK_SETUP_T setup;
+	bool result = false;
+
+	if (id < os_adc_count)
+	{
+		hw = &os_adc_hw[id];
+		stream->id = id;
+		stream->dmaErrors = 0;
+		os_pingpong_init(&stream->pingPong, stream->blocks[0], stream->blocks[1]);
+
+		os_dma_init();
+		stream->dmaChannel = os_dma_allocChannel(os_adc_dmaCallback, stream);
+
+		if (OS_DMA_NO_CHANNEL != stream->dmaChannel)
+		{
+			Chip_ADC_Init(hw->adc, &setup);
+			Chip_ADC_SetSampleRate(hw->adc, &setup, sampleRate);
+			Chip_ADC_EnableChannel(hw->adc, channel, ENABLE);
+
+			/* La "interrupción" del canal es la que genera el pedido de DMA; la
+			 * interrupción del ADC en el NVIC queda deshabilitada */
+			Chip_ADC_Int_SetChannelCmd(hw->adc, channel, ENABLE);
+
+			/* Cada bloque es un descriptor que enlaza con el otro e interrumpe al
+			 * completarse, por lo que el DMA nunca se detiene */
+			Chip_GPDMA_InitDescriptor(LPC_GPDMA, &stream->descriptors[0], hw->connection,
+					(uint32_t)stream->blocks[0], OS_ADC_BLOCK_SAMPLES,
+					GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, &stream->descriptors[1]);
+			Chip_GPDMA_InitDescriptor(LPC_GPDMA, &stream->descriptors[1], hw->connection,
+					(uint32_t)stream->blocks[1], OS_ADC_BLOCK_SAMPLES,
+					GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, &stream->descriptors[0]);
+			stream->descriptors[0].ctrl |= GPDMA_DMACCxControl_I;
+			stream->descriptors[1].ctrl |= GPDMA_DMACCxControl_I;
+			Chip_GPDMA_SGTransfer(LPC_GPDMA, stream->dmaChannel, &stream->descriptors[0],
+					GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA);
+
+			Chip_ADC_SetBurstCmd(hw->adc, ENABLE);
+			result = true;
+		}
+	}
+
+	return result;
+}
+
+int16_t * os_adc_receiveBlock(os_AdcStream_t * stream, uint32_t timeout)
+{
+	uint32_t * raw = os_pingpong_receive(&stream->pingPong, timeout);
+
+	if (NULL != raw)
+	{
+		os_dsp_adcToQ15((int16_t *)raw, raw, OS_ADC_BLOCK_SAMPLES);
+	}
+
+	return ((int16_t *)raw);
+}
+
+void os_adc_releaseBlock(os_AdcStream_t * stream)
+{
+	os_pingpong_release(&stream->pingPong);
+}
+
+/******************************************************************************
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief El DMA completó un bloque.
+ *
+ *  @details
+ *   Los descriptores enlazados ya dirigen al DMA hacia el otro bloque, por
+ *   lo que solo se entrega el bloque completo a la tarea. Ante un error el
+ *   GPDMA deshabilita el canal: el bloque a medio escribir se descarta y
+ *   se reanuda la transferencia enlazada sobre el mismo bloque.
+ *
+ *  @param channel				canal del GPDMA
+ *  @param error				true si la transferencia falló
+ *  @param *param				adquisición
+ *  @return     none.
+******************************************************************************/
+static void os_adc_dmaCallback(uint8_t channel, bool error, void * param)
+{
+	os_AdcStream_t * stream = (os_AdcStream_t *)param;
+
+	if (error)
+	{
+		stream->dmaErrors++;
+		Chip_GPDMA_SGTransfer(LPC_GPDMA, channel,
+				&stream->descriptors[stream->pingPong.writeBlock],
+				GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA);
+	}
+	else
+	{
+		os_pingpong_blockFilled(&stream->pingPong);
+	}
+}
@@ -10,46 +10,115 @@
 
 /*==================[inclusions]=============================================*/
 #include "MSE_OS_Core.h"
+#include "MSE_OS_API.h"
+#include "MSE_OS_Timer.h"
 #include "board.h"
+#include <stddef.h>
 
 /*==================[macros and definitions]=================================*/
-#define OS_MAX_ALLOWED_TASKS	8
+#define OS_MAX_ALLOWED_TASKS	OS_CONFIG_MAX_TASKS
+
+/* Bitmap de prioridades con tareas listas: con más de 32 prioridades se agrega
+ * un segundo nivel que indica qué palabras del bitmap tienen algún bit activo */
+#if (OS_PRIORITY_LEVELS > 32)
+#define OS_READY_BITMAP_TWO_LEVELS
+#define OS_READY_BITMAP_WORDS	((OS_PRIORITY_LEVELS + 31) / 32)
+#endif
+
+/* Atributos opcionales de ubicación de los pools de TCBs y stacks */
+#ifdef OS_CONFIG_TCB_SECTION
+#define OS_TCB_POOL_ATTRIBUTES		__attribute__((section(OS_CONFIG_TCB_SECTION)))
+#else
+#define OS_TCB_POOL_ATTRIBUTES
+#endif
+
+#ifdef OS_CONFIG_STACK_SECTION
+#define OS_STACK_POOL_ATTRIBUTES	__attribute__((section(OS_CONFIG_STACK_SECTION), aligned(8)))
+#else
+#define OS_STACK_POOL_ATTRIBUTES	__attribute__((aligned(8)))
+#endif
+
+#ifdef OS_CONFIG_CONTROL_SECTION
+#define OS_CONTROL_ATTRIBUTES		__attribute__((section(OS_CONFIG_CONTROL_SECTION)))
+#else
+#define OS_CONTROL_ATTRIBUTES
+#endif
+
+/* La tarea idle ocupa la última posición de los pools */
+#define OS_IDLE_TASK	(&os_tasksPool[OS_MAX_ALLOWED_TASKS])
+
+/* La prioridad 0 (la mayor) ocupa el bit 31 de cada palabra para que __CLZ
+ * devuelva directamente la prioridad más alta con tareas listas */
+#define OS_PRIORITY_BIT(priority)	(0x80000000UL >> ((priority) & 0x1F))
 
 /*==================[internal data definition]===============================*/
 typedef struct
 {
-	os_TaskHandler_t *tasks[OS_MAX_ALLOWED_TASKS];
-	uint8_t actualTaskId;
-	uint8_t numberOfTasks;
+	os_TaskHandler_t *actualTask;	/** última tarea seleccionada del grupo (lista circular) */
+	os_taskId_t readyTasks;			/** tareas del grupo en estado ready o running */
 
 } os_schedule_elem_t;
 
 typedef struct
 {
-	os_schedule_elem_t tasksGroupedByPriority[OS_CONTROL_MAX_PRIORITY+1];
+	os_schedule_elem_t tasksGroupedByPriority[OS_PRIORITY_LEVELS];
+#ifdef OS_READY_BITMAP_TWO_LEVELS
+	uint32_t readyGroups;
+	uint32_t readyBitmap[OS_READY_BITMAP_WORDS];
+#else
+	uint32_t readyBitmap;
+#endif
+#ifdef OS_CONFIG_EDF_PRIORITY
+	/** Tareas EDF listas ordenadas por deadline (min-heap). Su cantidad es la
+	 *  de tareas listas del grupo de OS_CONFIG_EDF_PRIORITY */
+	os_TaskHandler_t * edfHeap[OS_MAX_ALLOWED_TASKS];
+#endif
 
 } os_schedule_control_t;
 
 
 typedef struct
 {
-	os_schedule_control_t schedule;
-	uint8_t actualTaskIndex;
-	uint8_t tasksAdded;
+	/* PendSV_Handler accede a estos tres campos por offset: no reordenar */
 	os_TaskHandler_t * actualTask;
 	os_TaskHandler_t * nextTask;
+	bool schedulingFromIRQ;
+	os_schedule_control_t schedule;
+	os_taskId_t tasksAdded;
 	os_control_error_t error;
 	os_control_state_t state;
 	bool contextChangeNeeded;
 	int16_t tasksInCriticalZone;
-	bool schedulingFromIRQ;
-	uint32_t systemClockTicks;
+	uint64_t systemClockTicks;
+	uint32_t cyclesPerUs;	/** ciclos de CPU por microsegundo */
+	uint32_t usPerTick;		/** microsegundos por tick */
+	uint32_t statsStartTick;	/** tick del último reinicio de las estadísticas */
+	os_TaskHandler_t * freeTasks;	/** TCBs de tareas eliminadas, enlazados por nextInPriority */
+	os_TaskHandler_t * deletedActualTask;	/** tarea autoeliminada, aún no liberada */
+	uint16_t schedulerLocks;	/** anidamiento de os_lock_scheduler */
+	bool schedulePending;		/** scheduling diferido mientras el scheduler estaba bloqueado */
+#ifdef OS_CONFIG_PROFILE_CYCLES
+	os_kernelCycles_t cycles;
+#endif
 } os_control_t;
 
+/* Offsets utilizados por PendSV_Handler.S */
+_Static_assert(offsetof(os_control_t, actualTask) == 0, "PendSV_Handler.S: OS_CONTROL_ACTUAL");
+_Static_assert(offsetof(os_control_t, nextTask) == 4, "PendSV_Handler.S: OS_CONTROL_NEXT");
+_Static_assert(offsetof(os_control_t, schedulingFromIRQ) == 8, "PendSV_Handler.S: OS_CONTROL_FROM_IRQ");
+_Static_assert(offsetof(os_TaskHandler_t, stackPointer) == 0, "PendSV_Handler.S: TCB stackPointer");
+
 /*==================[Private data declaration]==============================*/
 
-static os_control_t os_control;
-static os_TaskHandler_t os_idleTask;
+/* Sin static: PendSV_Handler.S lee actualTask y nextTask directamente */
+os_control_t os_control OS_CONTROL_ATTRIBUTES;
+static os_TaskHandler_t os_tasksPool[OS_MAX_ALLOWED_TASKS + 1] OS_TCB_POOL_ATTRIBUTES;
+static uint32_t os_stacksPool[OS_MAX_ALLOWED_TASKS + 1][STACK_SIZE/4] OS_STACK_POOL_ATTRIBUTES;
+
+#ifdef OS_TIME_SLICE_TICKS_BY_PRIORITY
+static const uint32_t os_timeSliceByPriority[OS_PRIORITY_LEVELS] =
+		OS_TIME_SLICE_TICKS_BY_PRIORITY;
+#endif
 
 /*==================[Weak functions definition]=============================*/
 
@@ -67,67 +136,180 @@ void __attribute__((weak)) taskIdleHook(void)  {
 }
 
 void __attribute__((weak)) errorHook(void *caller)  {
-	/* el error del sistema operativo se encuentra en os_control.error
-	 * TODO: agregar un método que devuelva el error*/
+	/* el error del sistema operativo puede consultarse con os_getError */
 	while(1);
 }
 
 /*==================[Static headers]=========================================*/
 
 static void setPendSV();
+static void os_requestContextChange(void);
+static void os_svcYield(void);
 static void os_schedule();
+static os_TaskHandler_t * os_select_next_task();
+static bool os_isTaskReadyToRun(os_TaskHandler_t * task);
+static uint32_t os_getTimeSlice(uint8_t priority);
+static void os_reloadTimeSlice(os_TaskHandler_t * task);
 static void initIdleTask();
+static os_TaskHandler_t* os_createTask(void* entryPoint, uint8_t priority,
+		uint32_t relativeDeadline);
+static void os_initTaskStack(os_TaskHandler_t * task, void* entryPoint);
+static void os_unlinkTaskFromPriority(os_TaskHandler_t * task);
+#ifdef OS_CONFIG_PROFILE_CYCLES
+static void os_recordCycles(uint32_t * last, uint32_t * max, uint32_t cycles);
+#endif
+static void os_detachWait(os_TaskHandler_t * task);
+static void os_setNextTask(os_TaskHandler_t * task);
+static void os_releaseDeletedTask(void);
+
+#ifdef OS_CONFIG_EDF_PRIORITY
+static bool os_edf_isEarlier(os_TaskHandler_t * a, os_TaskHandler_t * b);
+static void os_edf_siftUp(os_taskId_t index, os_TaskHandler_t * task);
+static void os_edf_siftDown(os_taskId_t index, os_TaskHandler_t * task, os_taskId_t size);
+static void os_edf_insert(os_TaskHandler_t * task, os_taskId_t size);
+static void os_edf_remove(os_TaskHandler_t * task, os_taskId_t size);
+#endif
 
 
 /******************************************************************************
  * Funciones públicas (descripción de las mimas en MSE_OS_API.h)
  *****************************************************************************/
 
-void os_InitTask(os_TaskHandler_t *taskHandler,
-		void* entryPoint,
-		uint8_t priority)
+os_TaskHandler_t* os_InitTask(void* entryPoint, uint8_t priority)
 {
+	os_TaskHandler_t * taskHandler = NULL;
 
-	if (os_control.tasksAdded >= OS_MAX_ALLOWED_TASKS)
-	{
-		os_control.error = os_control_error_max_task_exceeded;
-		errorHook(os_InitTask);
-	}
-	else if (priority > OS_CONTROL_MAX_PRIORITY)
+#ifdef OS_CONFIG_EDF_PRIORITY
+	if (OS_CONFIG_EDF_PRIORITY == priority)
 	{
-		os_control.error = os_control_error_task_max_priority_exceeded;
+		os_control.error = os_control_error_edf_priority_reserved;
 		errorHook(os_InitTask);
 	}
 	else
+#endif
 	{
-		taskHandler->stack[STACK_SIZE/4 - XPSR] = INIT_XPSR;					//necesario para bit thumb
-		taskHandler->stack[STACK_SIZE/4 - PC_REG] = (uint32_t)entryPoint;		//direccion de la tarea (ENTRY_POINT)
-		taskHandler->stack[STACK_SIZE/4 - LR] = (uint32_t)returnHook;			//Retorno en la rutina de la tarea. Esto no está permitido
-		/**
-		 * El valor previo de LR (que es EXEC_RETURN en este caso) es necesario dado que
-		 * en esta implementacion, se llama a una funcion desde dentro del handler de PendSV
-		 * con lo que el valor de LR se modifica por la direccion de retorno para cuando
-		 * se termina de ejecutar getContextoSiguiente
-		 */
-		taskHandler->stack[STACK_SIZE/4 - LR_PREV] = EXEC_RETURN;
+		taskHandler = os_createTask(entryPoint, priority, 0);
+	}
+
+	return (taskHandler);
+}
+
+#ifdef OS_CONFIG_EDF_PRIORITY
+os_TaskHandler_t* os_InitTaskEDF(void* entryPoint, uint32_t relativeDeadline)
+{
+	return (os_createTask(entryPoint, OS_CONFIG_EDF_PRIORITY, relativeDeadline));
+}
 
-		taskHandler->entryPoint = entryPoint;
+uint32_t os_getDeadlineMisses(os_TaskHandler_t * task)
+{
+	return (task->deadlineMisses);
+}
+#endif
+
+void os_task_delete(os_TaskHandler_t * task)
+{
+	bool deletingActual;
 
-		taskHandler->stackPointer = (uint32_t)
-				(taskHandler->stack + STACK_SIZE/4 - STACK_FRAME_ALL_RECORDS_SIZE);
+	if (NULL == task)
+	{
+		task = os_control.actualTask;
+	}
 
-		taskHandler->state = os_task_state__ready;
+	/* Con el scheduler bloqueado la tarea actual seguiría ejecutándose */
+	if ((task == os_control.actualTask) && (0 < os_control.schedulerLocks))
+	{
+		os_setError(os_control_error_scheduler_locked, os_task_delete);
+	}
+	else if ((NULL != task) && (OS_IDLE_TASK != task))
+	{
+		os_enter_critical_zone();
+		os_releaseDeletedTask();
+		deletingActual = (task == os_control.actualTask);
+		if (os_task_state__deleted != task->state)
+		{
+			/* Nada debe seguir apuntando al TCB ni al stack de la tarea */
+			os_detachWait(task);
+			os_timer_removeTask(task);
+			os_setTaskState(task, os_task_state__deleted);
+			os_unlinkTaskFromPriority(task);
+
+			/* La tarea actual todavía usa su stack: se libera recién cuando
+			 * otra tarea elimine o cree una tarea */
+			if (deletingActual)
+			{
+				os_control.deletedActualTask = task;
+			}
+			else
+			{
+				task->nextInPriority = os_control.freeTasks;
+				os_control.freeTasks = task;
+			}
+		}
+		os_exit_critical_zone();
 
-		taskHandler->taskID = os_control.tasksAdded;
+		/* Puede despertar a tareas que esperaban alguno de sus semáforos o
+		 * de sus locks de escritura */
+		os_sem_releaseTask(task);
+		os_rwlock_releaseTask(task);
 
-		taskHandler->priority = priority;
+		/* La tarea eliminada puede ser la actual o la ya seleccionada como
+		 * siguiente: en ambos casos se vuelve a elegir. No se usa os_CpuYield,
+		 * que le quitaría el quantum a la tarea que llama */
+		if (deletingActual || (task == os_control.nextTask))
+		{
+			if (os_control_state__running_from_IRQ == os_control.state)
+			{
+				os_setSchedulingFromIRQ();
+			}
+			else
+			{
+				os_schedule();
+			}
+		}
+	}
+}
 
-		os_control.schedule.tasksGroupedByPriority[priority].tasks[
-		      os_control.schedule.tasksGroupedByPriority[priority].numberOfTasks] = taskHandler;
+void os_task_suspend(os_TaskHandler_t * task)
+{
+	if (NULL == task)
+	{
+		task = os_control.actualTask;
+	}
+
+	if ((task == os_control.actualTask) && (0 < os_control.schedulerLocks))
+	{
+		os_setError(os_control_error_scheduler_locked, os_task_suspend);
+	}
+	else if ((NULL != task) && (OS_IDLE_TASK != task))
+	{
+		os_enter_critical_zone();
+		if ((os_task_state__suspended != task->state) &&
+			(os_task_state__deleted != task->state))
+		{
+			os_detachWait(task);
+			os_setTaskState(task, os_task_state__suspended);
+		}
+		os_exit_critical_zone();
 
-		os_control.schedule.tasksGroupedByPriority[priority].numberOfTasks++;
+		if ((task == os_control.actualTask) || (task == os_control.nextTask))
+		{
+			if (os_control_state__running_from_IRQ == os_control.state)
+			{
+				os_setSchedulingFromIRQ();
+			}
+			else
+			{
+				os_schedule();
+			}
+		}
+	}
+}
 
-		os_control.tasksAdded++;
+void os_task_resume(os_TaskHandler_t * task)
+{
+	if ((NULL != task) && (os_task_state__suspended == task->state))
+	{
+		os_setTaskReady(task);
 	}
 }
 
@@ -135,6 +317,7 @@ void os_Init(void)
 {
 
 	NVIC_SetPriority(PendSV_IRQn, (1 << __NVIC_PRIO_BITS)-1);
+	NVIC_SetPriority(SVCall_IRQn, (1 << __NVIC_PRIO_BITS)-1);
 
 	initIdleTask();
 
@@ -145,48 +328,273 @@ void os_Init(void)
 	os_control.state = os_control_state__os_from_reset;
 
 	os_control.tasksInCriticalZone = 0;
+	os_control.schedulerLocks = 0;
+	os_control.schedulePending = false;
+	os_control.deletedActualTask = NULL;
 
-	os_setSchedulingFromIRQ(false);
+	os_clearSchedulingFromIRQ();
 
 	os_control.systemClockTicks = 0;
+
+	/* SysTick ya debe estar configurado: su período define la duración del tick */
+	os_control.cyclesPerUs = SystemCoreClock / 1000000;
+	os_control.usPerTick = (SysTick->LOAD + 1) / os_control.cyclesPerUs;
+
+#ifdef OS_CONFIG_PROFILE_CYCLES
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
 }
 
-uint32_t getContextoSiguiente(uint32_t p_stack_actual)
+uint32_t os_getFirstContext(void)
 {
-	/* por defecto continuo con la tarea actual*/
-	uint32_t p_stack_siguiente = p_stack_actual;
+	os_control.actualTask = os_control.nextTask;
+	os_control.actualTask->state = os_task_state__running;
+	os_control.state = os_control_state__os_running;
 
-	if (os_control_state__os_from_reset == os_control.state)
+	return (os_control.actualTask->stackPointer);
+}
+
+OS_RAMFUNC void os_scheduleFromPendSV(void)
+{
+#ifdef OS_CONFIG_PROFILE_CYCLES
+	uint32_t startCycles = DWT->CYCCNT;
+#endif
+
+	/* os_schedule decide con las interrupciones deshabilitadas, por lo que
+	 * PendSV nunca interrumpe una decisión a medias. Si aun así el SO no está
+	 * en running, schedulingFromIRQ queda activo y la decisión la toma el
+	 * próximo os_schedule */
+	if (os_control_state__os_running == os_control.state)
+	{
+		os_control.schedulingFromIRQ = false;
+
+		/* Con el scheduler bloqueado no se cambia de tarea: la decisión queda
+		 * pendiente para os_unlock_scheduler */
+		if (0 < os_control.schedulerLocks)
+		{
+			os_control.schedulePending = true;
+		}
+		else
+		{
+			os_setNextTask(os_select_next_task());
+		}
+	}
+
+#ifdef OS_CONFIG_PROFILE_CYCLES
+	os_recordCycles(&os_control.cycles.switchLast, &os_control.cycles.switchMax,
+			DWT->CYCCNT - startCycles);
+#endif
+}
+
+void os_CpuYield(void)
+{
+	/* Ceder el CPU implica renunciar a lo que resta del quantum */
+	if ((NULL != os_control.actualTask) &&
+		(os_control_state__running_from_IRQ != os_control.state))
+	{
+		os_control.actualTask->sliceTicks = 0;
+	}
+
+	os_schedule();
+}
+
+void os_setTaskReady(os_TaskHandler_t * task)
+{
+	os_setTaskState(task, os_task_state__ready);
+
+	/* Si la tarea despertada es mas prioritaria que la actual (0 es la mayor
+	 * prioridad), o si ambas son EDF y la despertada tiene un deadline más
+	 * próximo, se pide el cambio de contexto sin esperar al proximo tick */
+	if ((NULL != os_control.actualTask) &&
+		((task->priority < os_control.actualTask->priority)
+#ifdef OS_CONFIG_EDF_PRIORITY
+		|| ((OS_CONFIG_EDF_PRIORITY == task->priority) &&
+			(OS_CONFIG_EDF_PRIORITY == os_control.actualTask->priority) &&
+			os_edf_isEarlier(task, os_control.actualTask))
+#endif
+		))
+	{
+		if (os_control_state__running_from_IRQ == os_control.state)
+		{
+			os_setSchedulingFromIRQ();
+		}
+		else
+		{
+			os_schedule();
+		}
+	}
+}
+
+OS_RAMFUNC void os_setTaskState(os_TaskHandler_t * task, os_TaskState_t newState)
+{
+	os_schedule_elem_t * group;
+	bool wasReady, isReady;
+	uint32_t primask;
+
+	/* La tarea idle no pertenece a ningún grupo de prioridad */
+	if (OS_IDLE_TASK == task)
 	{
-		p_stack_siguiente = os_control.actualTask->stackPointer;
-		os_control.actualTask->state = os_task_state__running;
-		os_control.state = os_control_state__os_running;
+		task->state = newState;
 	}
 	else
 	{
+		/* Se guarda PRIMASK en lugar de usar os_enter_critical_zone porque esta
+		 * rutina también se llama desde los handlers de SysTick y PendSV */
+		primask = __get_PRIMASK();
+		__disable_irq();
 
-		os_control.actualTask->stackPointer = p_stack_actual;
+		wasReady = os_isTaskReadyToRun(task);
+		task->state = newState;
+		isReady = os_isTaskReadyToRun(task);
 
-		if (os_task_state__running == os_control.actualTask->state)
+		/* Fuera del estado bloqueado la tarea no espera ningún objeto */
+		if (os_task_state__blocked != newState)
 		{
-			os_control.actualTask->state = os_task_state__ready;
+			os_detachWait(task);
 		}
 
-		p_stack_siguiente = os_control.nextTask->stackPointer;
+		group = &os_control.schedule.tasksGroupedByPriority[task->priority];
 
-		os_control.actualTask = os_control.nextTask;
-		os_control.actualTask->state = os_task_state__running;
+		if (wasReady && !isReady)
+		{
+			group->readyTasks--;
+#ifdef OS_CONFIG_EDF_PRIORITY
+			if (OS_CONFIG_EDF_PRIORITY == task->priority)
+			{
+				os_edf_remove(task, group->readyTasks);
+
+				/* Bloquearse marca el fin del trabajo actual */
+				if ((os_task_state__blocked == newState) &&
+					((int32_t)((uint32_t)os_control.systemClockTicks - task->deadline) > 0))
+				{
+					task->deadlineMisses++;
+				}
+			}
+#endif
+			if (0 == group->readyTasks)
+			{
+#ifdef OS_READY_BITMAP_TWO_LEVELS
+				os_control.schedule.readyBitmap[task->priority >> 5] &= ~OS_PRIORITY_BIT(task->priority);
+				if (0 == os_control.schedule.readyBitmap[task->priority >> 5])
+				{
+					os_control.schedule.readyGroups &= ~OS_PRIORITY_BIT(task->priority >> 5);
+				}
+#else
+				os_control.schedule.readyBitmap &= ~OS_PRIORITY_BIT(task->priority);
+#endif
+			}
+		}
+		else if (!wasReady && isReady)
+		{
+#ifdef OS_CONFIG_EDF_PRIORITY
+			/* Pasar a ready libera un nuevo trabajo de la tarea */
+			if (OS_CONFIG_EDF_PRIORITY == task->priority)
+			{
+				task->deadline = (uint32_t)os_control.systemClockTicks + task->relativeDeadline;
+				os_edf_insert(task, group->readyTasks);
+			}
+#endif
+			if (0 == group->readyTasks)
+			{
+#ifdef OS_READY_BITMAP_TWO_LEVELS
+				os_control.schedule.readyBitmap[task->priority >> 5] |= OS_PRIORITY_BIT(task->priority);
+				os_control.schedule.readyGroups |= OS_PRIORITY_BIT(task->priority >> 5);
+#else
+				os_control.schedule.readyBitmap |= OS_PRIORITY_BIT(task->priority);
+#endif
+			}
+			group->readyTasks++;
+		}
 
+		__set_PRIMASK(primask);
 	}
+}
+
+os_TaskHandler_t* os_blockActualTaskOn(os_TaskHandler_t ** waitSlot, uint32_t timeout)
+{
+	os_TaskHandler_t * task = os_blockActualTask(timeout);
 
-	return(p_stack_siguiente);
+	task->waitSlot = waitSlot;
+	task->nextWaiting = NULL;
+	*waitSlot = task;
+
+	return (task);
 }
 
-void os_CpuYield(void)
+os_TaskHandler_t* os_blockActualTaskOnList(os_TaskHandler_t ** waitList, uint32_t timeout)
 {
-	os_schedule();
+	os_TaskHandler_t * task = os_blockActualTask(timeout);
+	os_TaskHandler_t ** link = waitList;
+
+	/* Detrás de las tareas de igual o mayor prioridad (0 es la mayor) */
+	while ((NULL != *link) && ((*link)->priority <= task->priority))
+	{
+		link = &(*link)->nextWaiting;
+	}
+
+	task->nextWaiting = *link;
+	if (NULL != task->nextWaiting)
+	{
+		task->nextWaiting->waitSlot = &task->nextWaiting;
+	}
+	task->waitSlot = link;
+	*link = task;
+
+	return (task);
+}
+
+os_TaskHandler_t* os_blockActualTask(uint32_t timeout)
+{
+	os_TaskHandler_t * task = os_control.actualTask;
+
+	/* blockedTicks en cero significa espera sin timeout: el tick no la despierta */
+	task->blockedTicks = (OS_WAIT_FOREVER == timeout) ? 0 : timeout;
+	os_setTaskState(task, os_task_state__blocked);
+
+	return (task);
+}
+
+void os_wakeUpWaitingTask(os_TaskHandler_t ** waitingTask)
+{
+	os_TaskHandler_t* task = *waitingTask;
+
+	if ((NULL != task) &&
+			(os_task_state__blocked == task->state))
+	{
+		*waitingTask = NULL;
+		os_setTaskReady(task);
+	}
+}
+
+os_TaskHandler_t* os_wakeUpFirstWaitingTask(os_TaskHandler_t ** waitList)
+{
+	os_TaskHandler_t* task = *waitList;
+
+	/* Al pasar a ready la tarea se quita sola de la lista (os_detachWait) */
+	if (NULL != task)
+	{
+		os_setTaskReady(task);
+	}
+
+	return (task);
 }
 
+uint32_t os_getRemainingTimeout(os_TaskHandler_t ** waitingTask,
+		os_TaskHandler_t * task, uint32_t timeout)
+{
+	if (OS_WAIT_FOREVER != timeout)
+	{
+		timeout = task->blockedTicks;
+		if ((OS_NO_WAIT == timeout) && (task == *waitingTask))
+		{
+			*waitingTask = NULL;
+		}
+	}
+
+	return (timeout);
+}
 
 os_TaskHandler_t* os_getActualtask()
 {
@@ -219,6 +627,40 @@ void os_exit_critical_zone()
 	}
 }
 
+void os_lock_scheduler(void)
+{
+	if (os_control_state__running_from_IRQ != os_control.state)
+	{
+		os_enter_critical_zone();
+		os_control.schedulerLocks++;
+
+		/* PendSV cambia de tarea sin consultar el lock: un cambio ya decidido
+		 * (dentro de una sección crítica) se revierte y queda pendiente */
+		if ((os_control.nextTask != os_control.actualTask) &&
+			(NULL != os_control.actualTask) &&
+			os_isTaskReadyToRun(os_control.actualTask))
+		{
+			os_setNextTask(os_control.actualTask);
+			os_control.schedulePending = true;
+		}
+		os_exit_critical_zone();
+	}
+}
+
+void os_unlock_scheduler(void)
+{
+	if ((os_control_state__running_from_IRQ != os_control.state) &&
+		(0 < os_control.schedulerLocks))
+	{
+		os_control.schedulerLocks--;
+		if ((0 == os_control.schedulerLocks) && os_control.schedulePending)
+		{
+			os_control.schedulePending = false;
+			os_schedule();
+		}
+	}
+}
+
 void os_setSchedulingFromIRQ()
 {
 	os_control.schedulingFromIRQ = true;
@@ -229,6 +671,11 @@ void os_clearSchedulingFromIRQ()
 	os_control.schedulingFromIRQ = false;
 }
 
+void os_pendSchedulingFromIRQ()
+{
+	setPendSV();
+}
+
 bool os_isSchedulingFromIRQ()
 {
 	return(os_control.schedulingFromIRQ);
@@ -240,129 +687,477 @@ void os_setError(os_control_error_t err, void* caller)
 	errorHook(caller);
 }
 
+os_control_error_t os_getError(void)
+{
+	return (os_control.error);
+}
+
+os_taskId_t os_getTaskCount(void)
+{
+	return (os_control.tasksAdded);
+}
+
+os_TaskHandler_t* os_getTask(os_taskId_t id)
+{
+	os_TaskHandler_t * task = NULL;
+
+	if (OS_IDLE_TASK_ID == id)
+	{
+		task = OS_IDLE_TASK;
+	}
+	else if (id < os_control.tasksAdded)
+	{
+		task = &os_tasksPool[id];
+	}
+
+	return (task);
+}
+
+uint32_t os_getStackFreeBytes(os_TaskHandler_t * task)
+{
+	uint32_t freeWords = 0;
+
+	/* El stack crece hacia abajo: el fondo es la primera palabra del arreglo */
+	while ((freeWords < STACK_SIZE/4) &&
+		(OS_STACK_PAINT_PATTERN == task->stack[freeWords]))
+	{
+		freeWords++;
+	}
+
+	return (freeWords * 4);
+}
+
+uint32_t os_getStatsTicks(void)
+{
+	return ((uint32_t)os_control.systemClockTicks - os_control.statsStartTick);
+}
+
+void os_resetTaskStats(void)
+{
+	os_taskId_t i;
+
+	for (i = 0; i < os_control.tasksAdded; i++)
+	{
+		os_tasksPool[i].runTicks = 0;
+	}
+	OS_IDLE_TASK->runTicks = 0;
+
+	os_control.statsStartTick = (uint32_t)os_control.systemClockTicks;
+
+#ifdef OS_CONFIG_PROFILE_CYCLES
+	os_control.cycles.tickMax = 0;
+	os_control.cycles.switchMax = 0;
+#endif
+}
+
+#ifdef OS_CONFIG_PROFILE_CYCLES
+void os_getKernelCycles(os_kernelCycles_t * cycles)
+{
+	*cycles = os_control.cycles;
+}
+#endif
+
 uint32_t os_get_systemClockMs()
 {
-	return(os_control.systemClockTicks);
+	return((uint32_t)os_control.systemClockTicks);
 }
 
-/******************************************************************************
- * Funciones privadas
- *****************************************************************************/
-/******************************************************************************
- *  @brief Inicialización de la tarea Idle
- *
- *  @details
- *   La tarea Idle es una tarea que se ejecuta cuando ninguna otra tarea
- *   esté en condiciones de ser ejecutada
- *
- *  @return     none.
- *****************************************************************************/
-static void initIdleTask()
+uint64_t os_get_systemClockUs(void)
 {
-	os_idleTask.stack[STACK_SIZE/4 - XPSR] = INIT_XPSR;					//necesario para bit thumb
-	os_idleTask.stack[STACK_SIZE/4 - PC_REG] = (uint32_t)taskIdleHook;		//direccion de la tarea (ENTRY_POINT)
-	os_idleTask.stack[STACK_SIZE/4 - LR] = (uint32_t)returnHook;			//Retorno en la rutina de la tarea. Esto no está permitido
-			/**
-			 * El valor previo de LR (que es EXEC_RETURN en este caso) es necesario dado que
-			 * en esta implementacion, se llama a una funcion desde dentro del handler de PendSV
-			 * con lo que el valor de LR se modifica por la direccion de retorno para cuando
-			 * se termina de ejecutar getContextoSiguiente
-			 */
-	os_idleTask.stack[STACK_SIZE/4 - LR_PREV] = EXEC_RETURN;
+	uint64_t ticks;
+	uint32_t elapsedCycles;
+	uint32_t primask = __get_PRIMASK();
 
-	os_idleTask.entryPoint = taskIdleHook;
+	__disable_irq();
+	ticks = os_control.systemClockTicks;
+	elapsedCycles = SysTick->LOAD - SysTick->VAL;
 
-	os_idleTask.stackPointer = (uint32_t) (os_idleTask.stack + STACK_SIZE/4 - STACK_FRAME_ALL_RECORDS_SIZE);
+	/* Si SysTick llegó a cero pero su interrupción todavía no se atendió, ese
+	 * tick aún no está contado y VAL pudo haberse recargado entre ambas
+	 * lecturas: se cuenta el tick y se vuelve a leer VAL */
+	if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+	{
+		ticks++;
+		elapsedCycles = SysTick->LOAD - SysTick->VAL;
+	}
+	__set_PRIMASK(primask);
 
-	os_idleTask.state = os_task_state__ready;
+	return (ticks * os_control.usPerTick) + (elapsedCycles / os_control.cyclesPerUs);
+}
 
-	os_idleTask.taskID = OS_IDLE_TASK_ID;
+uint32_t os_get_tickPeriodUs(void)
+{
+	return(os_control.usPerTick);
 }
 
 /******************************************************************************
- *  @brief Rutina de scheduling para tareas de la misma prioridad
- *
- *  @details
- *   Esta rutina es una rutina auxiliar utilizada por el scheduler.
- *   Particularmente se ocupa de seleccionar una tarea dentro de
- *   un conjunto de tareas de la misma prioridad
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief Crea una tarea tomando su TCB y su stack de los pools
  *
- *  @param priority					prioridad del grupo de tareas a analizar
- *  @return     none.
+ *  @param *entryPoint				rutina de la tarea
+ *  @param priority					prioridad de la tarea
+ *  @param relativeDeadline			deadline de cada trabajo (solo tareas EDF)
+ *  @return     puntero a la tarea, NULL si falló.
  *****************************************************************************/
-static os_TaskHandler_t * os_select_next_task_by_pririty(uint8_t priority)
+static os_TaskHandler_t* os_createTask(void* entryPoint, uint8_t priority,
+		uint32_t relativeDeadline)
 {
-	uint8_t id;
-	bool seekForTask, allBlocked;
-	uint8_t blockedTasksCounter = 0;
-	os_TaskHandler_t * taskSelected = NULL;
+	os_schedule_elem_t * group;
+	os_TaskHandler_t * taskHandler = NULL;
 
-	id = os_control.schedule.tasksGroupedByPriority[priority].actualTaskId;
-	/* Solo buscar una posible tarea a ejecutar, si al menos hay una tarea
-	 * agregada en esta prioridad */
-	if (0 < os_control.schedule.tasksGroupedByPriority[priority].numberOfTasks)
+	if (priority > OS_CONTROL_MAX_PRIORITY)
+	{
+		os_control.error = os_control_error_task_max_priority_exceeded;
+		errorHook(os_createTask);
+	}
+	else
 	{
-		seekForTask = true;
-		allBlocked = false;
-		while (seekForTask)
+		/* Se reutiliza primero el TCB de una tarea eliminada (O(1)); si no hay,
+		 * se toma el siguiente del pool */
+		os_enter_critical_zone();
+		os_releaseDeletedTask();
+		if (NULL != os_control.freeTasks)
 		{
-			id++;
-			if (id >= os_control.schedule.tasksGroupedByPriority[priority].numberOfTasks)
-			{
-				id = 0;
-			}
-			switch (os_control.schedule.tasksGroupedByPriority[priority].tasks[id]->state)
-			{
-				case 	os_task_state__ready:
-					seekForTask = false;
-					break;
-				case	os_task_state__blocked:
-					blockedTasksCounter++;
-					if (blockedTasksCounter >=
-							os_control.schedule.tasksGroupedByPriority[priority].numberOfTasks)
-					{
-						/*all tasks blocked*/
-						seekForTask = false;
-						allBlocked = true;
-					}
-					break;
-				case os_task_state__running:
-					/*all tasks are blocked except the one that was running*/
-					seekForTask = false;
-					break;
-				case os_task_state__suspended:
-					/*Nothing to do now*/
-					break;
-				default:
-					os_control.state = os_control_state__os_error;
-					os_control.error = os_control_error_task_with_invalid_state;
-					seekForTask = false;
-					errorHook(os_select_next_task_by_pririty);
-			}
+			taskHandler = os_control.freeTasks;
+			os_control.freeTasks = taskHandler->nextInPriority;
+		}
+		else if (os_control.tasksAdded < OS_MAX_ALLOWED_TASKS)
+		{
+			taskHandler = &os_tasksPool[os_control.tasksAdded];
+			taskHandler->taskID = os_control.tasksAdded;
+			taskHandler->stack = os_stacksPool[os_control.tasksAdded];
+			os_control.tasksAdded++;
 		}
+		if (NULL != taskHandler)
+		{
+			taskHandler->state = os_task_state__suspended;
+		}
+		os_exit_critical_zone();
+	}
 
-		if (allBlocked)
+	if (NULL == taskHandler)
+	{
+		if (os_control_error_none == os_control.error)
 		{
-			/*No one task ready for actual priority */
-			taskSelected = NULL;
+			os_control.error = os_control_error_max_task_exceeded;
+			errorHook(os_createTask);
 		}
-		else if (id != os_control.schedule.tasksGroupedByPriority[priority].actualTaskId)
+	}
+	else
+	{
+		/* La tarea todavía no figura en el scheduler: su inicialización no
+		 * necesita sección crítica */
+		os_initTaskStack(taskHandler, entryPoint);
+
+		taskHandler->priority = priority;
+		taskHandler->blockedTicks = 0;
+		taskHandler->runTicks = 0;
+		taskHandler->waitSlot = NULL;
+		taskHandler->nextWaiting = NULL;
+
+		os_reloadTimeSlice(taskHandler);
+
+#ifdef OS_CONFIG_EDF_PRIORITY
+		taskHandler->relativeDeadline = relativeDeadline;
+		taskHandler->deadlineMisses = 0;
+#else
+		(void)relativeDeadline;
+#endif
+
+		/* Insertar la tarea en la lista circular de su prioridad, a continuación
+		 * de la última tarea seleccionada del grupo */
+		os_enter_critical_zone();
+		group = &os_control.schedule.tasksGroupedByPriority[priority];
+		if (NULL == group->actualTask)
 		{
-			os_control.schedule.tasksGroupedByPriority[priority].actualTaskId = id;
-			taskSelected = os_control.schedule.tasksGroupedByPriority[priority].tasks[id];
+			taskHandler->nextInPriority = taskHandler;
 		}
 		else
 		{
-			/*only actual task is ready to continue*/
-			taskSelected = os_control.schedule.tasksGroupedByPriority[priority].tasks[id];
+			taskHandler->nextInPriority = group->actualTask->nextInPriority;
+			group->actualTask->nextInPriority = taskHandler;
 		}
+		group->actualTask = taskHandler;
+		os_exit_critical_zone();
+
+		/* La tarea se crea ready: actualiza el bitmap de prioridades y, si el
+		 * sistema operativo ya está corriendo, puede desalojar a la actual */
+		os_setTaskReady(taskHandler);
 	}
 
-	return (taskSelected);
+	return (taskHandler);
 }
 
 /******************************************************************************
- *  @brief Implementa la política de scheduling.
+ *  @brief Quita una tarea de la lista circular de su prioridad
+ *
+ *  @details
+ *   Si era la última tarea seleccionada del grupo, su antecesora pasa a
+ *   serlo, de modo que la rotación continúa con la siguiente. Debe llamarse
+ *   dentro de una sección crítica.
+ *
+ *  @param *task				tarea a quitar
+ *  @return     none.
+ *****************************************************************************/
+static void os_unlinkTaskFromPriority(os_TaskHandler_t * task)
+{
+	os_schedule_elem_t * group = &os_control.schedule.tasksGroupedByPriority[task->priority];
+	os_TaskHandler_t * previous = task;
+
+	while (task != previous->nextInPriority)
+	{
+		previous = previous->nextInPriority;
+	}
+
+	if (previous == task)
+	{
+		group->actualTask = NULL;
+	}
+	else
+	{
+		previous->nextInPriority = task->nextInPriority;
+		if (group->actualTask == task)
+		{
+			group->actualTask = previous;
+		}
+	}
+}
+
+/******************************************************************************
+ *  @brief Quita a una tarea del objeto por el que espera
+ *
+ *  @details
+ *   Solo se modifica el campo del objeto si todavía apunta a la tarea. Si la
+ *   tarea está en una lista de espera, el enlace pasa a apuntar a la
+ *   siguiente; en los objetos de una sola tarea en espera nextWaiting es
+ *   nulo y el campo queda vacío. Debe llamarse dentro de una sección
+ *   crítica.
+ *
+ *  @param *task				tarea a quitar
+ *  @return     none.
+ *****************************************************************************/
+static OS_RAMFUNC void os_detachWait(os_TaskHandler_t * task)
+{
+	if ((NULL != task->waitSlot) && (task == *task->waitSlot))
+	{
+		*task->waitSlot = task->nextWaiting;
+		if (NULL != task->nextWaiting)
+		{
+			task->nextWaiting->waitSlot = task->waitSlot;
+		}
+	}
+	task->waitSlot = NULL;
+	task->nextWaiting = NULL;
+}
+
+/******************************************************************************
+ *  @brief Inicialización de la tarea Idle
+ *
+ *  @details
+ *   La tarea Idle es una tarea que se ejecuta cuando ninguna otra tarea
+ *   esté en condiciones de ser ejecutada
+ *
+ *  @return     none.
+ *****************************************************************************/
+static void initIdleTask()
+{
+	OS_IDLE_TASK->stack = os_stacksPool[OS_MAX_ALLOWED_TASKS];
+
+	os_initTaskStack(OS_IDLE_TASK, taskIdleHook);
+
+	OS_IDLE_TASK->state = os_task_state__ready;
+
+	OS_IDLE_TASK->taskID = OS_IDLE_TASK_ID;
+
+	/* La tarea idle tiene menor prioridad que cualquier tarea del usuario */
+	OS_IDLE_TASK->priority = OS_CONTROL_MAX_PRIORITY + 1;
+}
+
+/******************************************************************************
+ *  @brief Inicialización del stack de una tarea
+ *
+ *  @details
+ *   Pinta el stack con OS_STACK_PAINT_PATTERN y arma el stack frame
+ *   inicial para que el primer cambio de contexto hacia la tarea comience
+ *   a ejecutar su entry point. El puntero al stack de la tarea debe estar
+ *   asignado.
+ *
+ *  @param *task				tarea a inicializar
+ *  @param *entryPoint			rutina que ejecutará la tarea
+ *  @return     none.
+ *****************************************************************************/
+static void os_initTaskStack(os_TaskHandler_t * task, void* entryPoint)
+{
+	uint32_t i;
+
+	/* Pintar el stack para poder medir luego cuánto se utilizó */
+	for (i = 0; i < STACK_SIZE/4; i++)
+	{
+		task->stack[i] = OS_STACK_PAINT_PATTERN;
+	}
+
+	task->stack[STACK_SIZE/4 - XPSR] = INIT_XPSR;					//necesario para bit thumb
+	task->stack[STACK_SIZE/4 - PC_REG] = (uint32_t)entryPoint;		//direccion de la tarea (ENTRY_POINT)
+	task->stack[STACK_SIZE/4 - LR] = (uint32_t)returnHook;			//Retorno en la rutina de la tarea. Esto no está permitido
+	/**
+	 * El valor previo de LR (que es EXEC_RETURN en este caso) es necesario dado que
+	 * en esta implementacion, se llama a una funcion desde dentro del handler de PendSV
+	 * con lo que el valor de LR se modifica por la direccion de retorno para cuando
+	 * se termina de ejecutar os_scheduleFromPendSV
+	 */
+	task->stack[STACK_SIZE/4 - LR_PREV] = EXEC_RETURN;
+
+	task->entryPoint = entryPoint;
+
+	task->stackPointer = (uint32_t)
+			(task->stack + STACK_SIZE/4 - STACK_FRAME_ALL_RECORDS_SIZE);
+}
+
+/******************************************************************************
+ *  @brief Indica si una tarea está en condiciones de ejecutarse
+ *
+ *  @param *task					tarea a analizar
+ *  @return     true si la tarea está en estado ready o running.
+ *****************************************************************************/
+static OS_RAMFUNC bool os_isTaskReadyToRun(os_TaskHandler_t * task)
+{
+	return ((os_task_state__ready == task->state) ||
+			(os_task_state__running == task->state));
+}
+
+/******************************************************************************
+ *  @brief Fija la próxima tarea a ejecutar
+ *
+ *  @details
+ *   PendSV solo intercambia stacks, por lo que los pasajes entre running y
+ *   ready se hacen al tomar la decisión: la tarea elegida figura como
+ *   running y la elegida anteriormente, si no llegó a bloquearse, vuelve a
+ *   ready. No alteran el bitmap de prioridades, por lo que el estado se
+ *   escribe directamente. Debe llamarse con las interrupciones deshabilitadas.
+ *
+ *  @param *task					tarea seleccionada (ready o running)
+ *  @return     none.
+ *****************************************************************************/
+static OS_RAMFUNC void os_setNextTask(os_TaskHandler_t * task)
+{
+	os_TaskHandler_t * previous = os_control.nextTask;
+
+	if ((previous != task) &&
+		(NULL != previous) &&
+		(os_task_state__running == previous->state))
+	{
+		previous->state = os_task_state__ready;
+	}
+
+	os_control.nextTask = task;
+	task->state = os_task_state__running;
+}
+
+/******************************************************************************
+ *  @brief Libera el TCB de una tarea que se eliminó a sí misma
+ *
+ *  @details
+ *   El TCB pasa a la lista de libres solo si la tarea ya no es la actual,
+ *   es decir, si PendSV ya abandonó su stack. Debe llamarse dentro de una
+ *   sección crítica.
+ *
+ *  @return     none.
+ *****************************************************************************/
+static void os_releaseDeletedTask(void)
+{
+	os_TaskHandler_t * task = os_control.deletedActualTask;
+
+	if ((NULL != task) && (task != os_control.actualTask))
+	{
+		task->nextInPriority = os_control.freeTasks;
+		os_control.freeTasks = task;
+		os_control.deletedActualTask = NULL;
+	}
+}
+
+/******************************************************************************
+ *  @brief Rutina de scheduling para tareas de la misma prioridad
+ *
+ *  @details
+ *   Esta rutina es una rutina auxiliar utilizada por el scheduler.
+ *   Particularmente se ocupa de seleccionar una tarea dentro de
+ *   un conjunto de tareas de la misma prioridad. Solo se rota a la
+ *   siguiente tarea cuando la actual agota su quantum o se bloquea.
+ *   Debe llamarse solo para prioridades con al menos una tarea lista.
+ *
+ *  @param priority					prioridad del grupo de tareas a analizar
+ *  @return     tarea seleccionada.
+ *****************************************************************************/
+static OS_RAMFUNC os_TaskHandler_t * os_select_next_task_by_pririty(uint8_t priority)
+{
+	os_schedule_elem_t * group = &os_control.schedule.tasksGroupedByPriority[priority];
+	os_TaskHandler_t * taskSelected = group->actualTask;
+
+#ifdef OS_CONFIG_EDF_PRIORITY
+	/* Las tareas EDF no rotan: se ejecuta la de deadline más próximo */
+	if (OS_CONFIG_EDF_PRIORITY == priority)
+	{
+		taskSelected = os_control.schedule.edfHeap[0];
+	}
+	else
+#endif
+	/* Mientras la tarea actual de este grupo pueda ejecutarse y le quede quantum,
+	 * se continua con ella y no se rota (no hay cambio de contexto innecesario) */
+	if (!(os_isTaskReadyToRun(taskSelected) && (0 < taskSelected->sliceTicks)))
+	{
+		/* El bitmap garantiza que hay al menos una tarea lista en el grupo. Si es
+		 * la única, la búsqueda da la vuelta completa y vuelve a ella */
+		do
+		{
+			taskSelected = taskSelected->nextInPriority;
+		} while (!os_isTaskReadyToRun(taskSelected));
+
+		group->actualTask = taskSelected;
+		os_reloadTimeSlice(taskSelected);
+	}
+
+	return (taskSelected);
+}
+
+/******************************************************************************
+ *  @brief Selecciona la próxima tarea a ejecutar
+ *
+ *  @details
+ *   Obtiene del bitmap la mayor prioridad con tareas listas (costo
+ *   constante, sin importar la cantidad de prioridades configuradas) y
+ *   selecciona una tarea de ese grupo. Si ninguna tarea está lista,
+ *   devuelve la tarea idle.
+ *
+ *  @return     puntero a la tarea seleccionada.
+ *****************************************************************************/
+static OS_RAMFUNC os_TaskHandler_t * os_select_next_task()
+{
+	uint32_t priority;
+	os_TaskHandler_t * taskSelected = OS_IDLE_TASK;
+
+#ifdef OS_READY_BITMAP_TWO_LEVELS
+	if (0 != os_control.schedule.readyGroups)
+	{
+		priority = __CLZ(os_control.schedule.readyGroups);
+		priority = (priority << 5) + __CLZ(os_control.schedule.readyBitmap[priority]);
+		taskSelected = os_select_next_task_by_pririty(priority);
+	}
+#else
+	if (0 != os_control.schedule.readyBitmap)
+	{
+		priority = __CLZ(os_control.schedule.readyBitmap);
+		taskSelected = os_select_next_task_by_pririty(priority);
+	}
+#endif
+
+	return (taskSelected);
+}
+
+/******************************************************************************
+ *  @brief Implementa la política de scheduling.
  *
  *  @details
  *   Implementa una política de scheduling con prioridades. Para aquellas
@@ -371,10 +1166,19 @@ static os_TaskHandler_t * os_select_next_task_by_pririty(uint8_t priority)
  *
  *  @return     none.
  *****************************************************************************/
-static void os_schedule()
+static OS_RAMFUNC void os_schedule()
 {
-	uint8_t priority = 0;
 	os_TaskHandler_t * taskSelected = NULL;
+	bool contextChangeNeeded;
+	uint32_t primask;
+
+	/* La decisión se toma con las interrupciones deshabilitadas: si una
+	 * interrupción liberara un evento en medio de ella, PendSV tomaría su
+	 * propia decisión y podría cambiar de tarea dejando al SO en estado
+	 * scheduling. Se guarda PRIMASK porque también se llama desde SysTick y
+	 * desde secciones críticas */
+	primask = __get_PRIMASK();
+	__disable_irq();
 
 	os_control.contextChangeNeeded = false;
 
@@ -390,36 +1194,98 @@ static void os_schedule()
 		else
 		{
 			/*seleccionar la primer tarea para que sea ejecutada*/
-			/*se selecciona como primer tarea a ejecutar la tarea idle*/
-			os_control.actualTask = &os_idleTask;
+			/*se selecciona como primer tarea a ejecutar la tarea idle, que
+			 * PendSV arranca con os_getFirstContext*/
+			os_control.nextTask = OS_IDLE_TASK;
 			os_control.contextChangeNeeded = true;
 		}
 	}
+	else if (0 < os_control.schedulerLocks)
+	{
+		/* Se ejecutará una única vez al desbloquear el scheduler */
+		os_control.schedulePending = true;
+	}
 	else
 	{
 		/* Checkear que el SO no esté en medio de un scheduling en otro hilo */
 		if (os_control_state__os_running == os_control.state)
 		{
 			os_control.state = os_control_state__os_scheduling;
-			while ((OS_CONTROL_MAX_PRIORITY >= priority) && (NULL == taskSelected))
-			{
-				taskSelected = os_select_next_task_by_pririty(priority);
-				priority++;
-			}
-			if (NULL == taskSelected)
-			{
-				taskSelected = &os_idleTask;
-			}
+
+			taskSelected = os_select_next_task();
+
+			/* Esta decisión ya contempla los eventos liberados desde interrupciones */
+			os_control.schedulingFromIRQ = false;
+
 			os_control.contextChangeNeeded = (os_control.nextTask != taskSelected);
 
-			os_control.nextTask = taskSelected;
+			os_setNextTask(taskSelected);
 			os_control.state = os_control_state__os_running;
 		}
 	}
 
-	if (os_control.contextChangeNeeded)
+	contextChangeNeeded = os_control.contextChangeNeeded;
+
+	__set_PRIMASK(primask);
+
+	/* Fuera de la zona enmascarada: desde una tarea el cambio se hace con SVC */
+	if (contextChangeNeeded)
 	{
-		setPendSV();
+		os_requestContextChange();
+	}
+}
+
+/******************************************************************************
+ *  @brief Obtiene el quantum configurado para una prioridad
+ *
+ *  @param priority					prioridad a consultar
+ *  @return     quantum en ticks (OS_TIME_SLICE_COOPERATIVE si es infinito).
+ *****************************************************************************/
+static OS_RAMFUNC uint32_t os_getTimeSlice(uint8_t priority)
+{
+#ifdef OS_TIME_SLICE_TICKS_BY_PRIORITY
+	return (os_timeSliceByPriority[priority]);
+#else
+	(void)priority;
+	return (OS_TIME_SLICE_DEFAULT_TICKS);
+#endif
+}
+
+/******************************************************************************
+ *  @brief Recarga el quantum de una tarea
+ *
+ *  @details
+ *   Para las prioridades cooperativas el contador nunca se decrementa, por
+ *   lo que basta con dejarlo distinto de cero.
+ *
+ *  @param *task					tarea a la que se le recarga el quantum
+ *  @return     none.
+ *****************************************************************************/
+static OS_RAMFUNC void os_reloadTimeSlice(os_TaskHandler_t * task)
+{
+	uint32_t slice = os_getTimeSlice(task->priority);
+
+	task->sliceTicks = (OS_TIME_SLICE_COOPERATIVE == slice) ? 1 : slice;
+}
+
+/******************************************************************************
+ *  @brief Actualiza el quantum de la tarea en ejecución
+ *
+ *  @details
+ *   Esta rutina debe llamarse cada vez que se produce un tick del sistema.
+ *   La tarea idle y las prioridades cooperativas no consumen quantum.
+ *
+ *  @return     none.
+ *****************************************************************************/
+static OS_RAMFUNC void os_updateTimeSlice()
+{
+	os_TaskHandler_t * task = os_control.actualTask;
+
+	if ((NULL != task) && (OS_IDLE_TASK != task) &&
+		(OS_TIME_SLICE_COOPERATIVE != os_getTimeSlice(task->priority)) &&
+		(0 < task->sliceTicks))
+	{
+		task->sliceTicks--;
 	}
 }
 
@@ -433,27 +1299,173 @@ static void os_schedule()
  *
  *  @return     none.
  *****************************************************************************/
-static void os_updateTicksInAllTaskBlocked()
+static OS_RAMFUNC void os_updateTicksInAllTaskBlocked()
 {
-	uint8_t priorityID;
-	uint8_t i;
-	for (priorityID = 0; priorityID <= OS_CONTROL_MAX_PRIORITY; priorityID++)
+	os_taskId_t i;
+	os_TaskHandler_t * task;
+
+	for (i = 0; i < os_control.tasksAdded; i++)
 	{
-		for (i = 0; i< os_control.schedule.tasksGroupedByPriority[priorityID].numberOfTasks; i++)
+		task = &os_tasksPool[i];
+		if ((os_task_state__blocked == task->state) &&
+			(0 < task->blockedTicks))
 		{
-			if ((os_task_state__blocked == os_control.schedule.tasksGroupedByPriority[priorityID].tasks[i]->state) &&
-				(0 < os_control.schedule.tasksGroupedByPriority[priorityID].tasks[i]->blockedTicks))
+			task->blockedTicks--;
+			if (0 == task->blockedTicks)
 			{
-				os_control.schedule.tasksGroupedByPriority[priorityID].tasks[i]->blockedTicks--;
-				if (0 == os_control.schedule.tasksGroupedByPriority[priorityID].tasks[i]->blockedTicks)
-				{
-					os_control.schedule.tasksGroupedByPriority[priorityID].tasks[i]->state = os_task_state__ready;
-				}
+				os_setTaskState(task, os_task_state__ready);
 			}
 		}
 	}
 }
 
+#ifdef OS_CONFIG_EDF_PRIORITY
+
+/******************************************************************************
+ *  @brief Compara los deadlines de dos tareas EDF
+ *
+ *  @details
+ *   La comparación se hace por diferencia para seguir siendo válida cuando
+ *   el contador de ticks da la vuelta.
+ *
+ *  @param *a						primera tarea
+ *  @param *b						segunda tarea
+ *  @return     true si el deadline de a es anterior al de b.
+ *****************************************************************************/
+static OS_RAMFUNC bool os_edf_isEarlier(os_TaskHandler_t * a, os_TaskHandler_t * b)
+{
+	return ((int32_t)(a->deadline - b->deadline) < 0);
+}
+
+/******************************************************************************
+ *  @brief Ubica una tarea en el heap EDF subiendo desde una posición
+ *
+ *  @details
+ *   La posición indicada es un hueco: los padres con deadline posterior
+ *   bajan a ocuparlo y la tarea se escribe una única vez al final.
+ *
+ *  @param index					posición libre de partida
+ *  @param *task					tarea a ubicar
+ *  @return     none.
+ *****************************************************************************/
+static OS_RAMFUNC void os_edf_siftUp(os_taskId_t index, os_TaskHandler_t * task)
+{
+	os_TaskHandler_t ** heap = os_control.schedule.edfHeap;
+	os_taskId_t parent;
+
+	while ((0 < index) && os_edf_isEarlier(task, heap[(index - 1) / 2]))
+	{
+		parent = (index - 1) / 2;
+		heap[index] = heap[parent];
+		heap[index]->edfIndex = index;
+		index = parent;
+	}
+
+	heap[index] = task;
+	task->edfIndex = index;
+}
+
+/******************************************************************************
+ *  @brief Ubica una tarea en el heap EDF bajando desde una posición
+ *
+ *  @param index					posición libre de partida
+ *  @param *task					tarea a ubicar
+ *  @param size						cantidad de tareas en el heap
+ *  @return     none.
+ *****************************************************************************/
+static OS_RAMFUNC void os_edf_siftDown(os_taskId_t index, os_TaskHandler_t * task, os_taskId_t size)
+{
+	os_TaskHandler_t ** heap = os_control.schedule.edfHeap;
+	uint32_t child = 2 * (uint32_t)index + 1;
+	bool placed = false;
+
+	while ((child < size) && !placed)
+	{
+		if (((child + 1) < size) && os_edf_isEarlier(heap[child + 1], heap[child]))
+		{
+			child++;
+		}
+
+		if (os_edf_isEarlier(heap[child], task))
+		{
+			heap[index] = heap[child];
+			heap[index]->edfIndex = index;
+			index = child;
+			child = 2 * (uint32_t)index + 1;
+		}
+		else
+		{
+			placed = true;
+		}
+	}
+
+	heap[index] = task;
+	task->edfIndex = index;
+}
+
+/******************************************************************************
+ *  @brief Agrega una tarea lista al heap EDF
+ *
+ *  @param *task					tarea a agregar
+ *  @param size						cantidad de tareas en el heap antes de agregarla
+ *  @return     none.
+ *****************************************************************************/
+static OS_RAMFUNC void os_edf_insert(os_TaskHandler_t * task, os_taskId_t size)
+{
+	os_edf_siftUp(size, task);
+}
+
+/******************************************************************************
+ *  @brief Quita una tarea del heap EDF
+ *
+ *  @details
+ *   La última tarea del heap ocupa el lugar de la quitada y se reubica
+ *   hacia arriba o hacia abajo según su deadline.
+ *
+ *  @param *task					tarea a quitar
+ *  @param size						cantidad de tareas en el heap luego de quitarla
+ *  @return     none.
+ *****************************************************************************/
+static OS_RAMFUNC void os_edf_remove(os_TaskHandler_t * task, os_taskId_t size)
+{
+	os_TaskHandler_t ** heap = os_control.schedule.edfHeap;
+	os_TaskHandler_t * last = heap[size];
+	os_taskId_t index = task->edfIndex;
+
+	if (last != task)
+	{
+		if ((0 < index) && os_edf_isEarlier(last, heap[(index - 1) / 2]))
+		{
+			os_edf_siftUp(index, last);
+		}
+		else
+		{
+			os_edf_siftDown(index, last, size);
+		}
+	}
+}
+
+#endif
+
+#ifdef OS_CONFIG_PROFILE_CYCLES
+/******************************************************************************
+ *  @brief Registra una medición de ciclos
+ *
+ *  @param *last					última medición
+ *  @param *max						máxima medición
+ *  @param cycles					ciclos medidos
+ *  @return     none.
+ *****************************************************************************/
+static OS_RAMFUNC void os_recordCycles(uint32_t * last, uint32_t * max, uint32_t cycles)
+{
+	*last = cycles;
+	if (cycles > *max)
+	{
+		*max = cycles;
+	}
+}
+#endif
+
 /******************************************************************************
  *  @brief Activa el flag de PendSV.
  *
@@ -462,7 +1474,7 @@ static void os_updateTicksInAllTaskBlocked()
  *
  *  @return     none.
  *****************************************************************************/
-static void setPendSV()
+static OS_RAMFUNC void setPendSV()
 {
 	/**
 	 * Se setea el bit correspondiente a la excepcion PendSV
@@ -482,6 +1494,56 @@ static void setPendSV()
 	__DSB();
 }
 
+/******************************************************************************
+ *  @brief Pide el cambio de contexto
+ *
+ *  @details
+ *   Desde una tarea con las interrupciones habilitadas el cambio es una
+ *   cesión voluntaria del CPU y se hace en forma sincrónica con SVC, que no
+ *   guarda los registros caller-saved de la FPU. Desde una interrupción o
+ *   dentro de una sección crítica (donde SVC escalaría a HardFault) se usa
+ *   PendSV, que se ejecuta al salir de ellas.
+ *
+ *  @return     none.
+ *****************************************************************************/
+static OS_RAMFUNC void os_requestContextChange(void)
+{
+	if ((0 == __get_IPSR()) && (0 == __get_PRIMASK()))
+	{
+		os_svcYield();
+	}
+	else
+	{
+		setPendSV();
+	}
+}
+
+/******************************************************************************
+ *  @brief Cede el CPU a través de SVC_Handler
+ *
+ *  @details
+ *   SVC_Handler no guarda S0-S15: se declaran modificados en el asm, ya
+ *   que con -fipa-ra los llamadores del mismo archivo no asumen que una
+ *   llamada los destruye. Si la tarea tiene contexto de FPU (CONTROL.FPCA)
+ *   se le pasa el FPSCR en R0 para que el handler preserve sus bits de
+ *   modo; sin contexto de FPU el handler no lo usa y no se ejecuta ninguna
+ *   instrucción de FPU, que reservaría el stack frame extendido.
+ *
+ *  @return     none.
+ *****************************************************************************/
+static OS_RAMFUNC __attribute__((noinline)) void os_svcYield(void)
+{
+	__asm volatile (
+			"mrs r0, control		\n\t"
+			"tst r0, #4				\n\t"
+			"it ne					\n\t"
+			"vmrsne r0, fpscr		\n\t"
+			"svc #0"
+			::: "r0", "r1", "r2", "r3", "r12", "lr", "cc", "memory",
+			"s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7",
+			"s8", "s9", "s10", "s11", "s12", "s13", "s14", "s15");
+}
+
 
 
 /******************************************************************************
@@ -497,14 +1559,32 @@ static void setPendSV()
  *
  *  @return     none.
  *****************************************************************************/
-void SysTick_Handler(void)
+OS_RAMFUNC void SysTick_Handler(void)
 {
+#ifdef OS_CONFIG_PROFILE_CYCLES
+	uint32_t startCycles = DWT->CYCCNT;
+#endif
+
 	os_control.systemClockTicks++;
 
+	/* Uso del CPU por muestreo: el tick se le atribuye a la tarea interrumpida */
+	if (NULL != os_control.actualTask)
+	{
+		os_control.actualTask->runTicks++;
+	}
+
 	os_updateTicksInAllTaskBlocked();
 
+	os_updateTimeSlice();
+
 	os_schedule();
 
+#ifdef OS_CONFIG_PROFILE_CYCLES
+	/* El tickHook es código del usuario y no se incluye en la medición */
+	os_recordCycles(&os_control.cycles.tickLast, &os_control.cycles.tickMax,
+			DWT->CYCCNT - startCycles);
+#endif
+
 	/*Ejecutar el hook asociado al tick*/
 	tickHook();
 }
@@ -0,0 +1,113 @@
+/*
+ * MSE_OS_DMA.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Librería que reparte la interrupción del GPDMA entre los
+ *         drivers del sistema operativo
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_DMA.h"
+#include "MSE_OS_IRQ.h"
+
+/*==================[macros and definitions]=================================*/
+typedef struct
+{
+	os_dma_callback_t callback;
+	void * param;
+} os_dma_channel_t;
+
+/*==================[Static headers]=========================================*/
+
+static void os_dma_IRQHandler(void);
+
+/*==================[Private data declaration]==============================*/
+
+static os_dma_channel_t os_dma_channels[OS_DMA_NUMBER_OF_CHANNELS];
+static bool os_dma_initialized = false;
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_DMA.h)
+ *****************************************************************************/
+void os_dma_init(void)
+{
+	if (!os_dma_initialized)
+	{
+		Chip_GPDMA_Init(LPC_GPDMA);
+		os_insertIRQ(DMA_IRQn, os_dma_IRQHandler);
+		os_dma_initialized = true;
+	}
+}
+
+uint8_t os_dma_allocChannel(os_dma_callback_t callback, void * param)
+{
+	uint8_t channel = 0;
+
+	/* Los canales de menor número tienen mayor prioridad en el GPDMA */
+	os_enter_critical_zone();
+	while ((channel < OS_DMA_NUMBER_OF_CHANNELS) &&
+			(NULL != os_dma_channels[channel].callback))
+	{
+		channel++;
+	}
+
+	if (channel < OS_DMA_NUMBER_OF_CHANNELS)
+	{
+		os_dma_channels[channel].callback = callback;
+		os_dma_channels[channel].param = param;
+	}
+	else
+	{
+		channel = OS_DMA_NO_CHANNEL;
+	}
+	os_exit_critical_zone();
+
+	return channel;
+}
+
+void os_dma_freeChannel(uint8_t channel)
+{
+	if (channel < OS_DMA_NUMBER_OF_CHANNELS)
+	{
+		os_enter_critical_zone();
+		Chip_GPDMA_Stop(LPC_GPDMA, channel);
+		os_dma_channels[channel].callback = NULL;
+		os_dma_channels[channel].param = NULL;
+		os_exit_critical_zone();
+	}
+}
+
+/******************************************************************************
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief Handler de la interrupción del GPDMA.
+ *
+ *  @details
+ *   Limpia los flags de cada canal que interrumpió y ejecuta su callback.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_dma_IRQHandler(void)
+{
+	uint32_t pending = LPC_GPDMA->INTSTAT;
+	uint32_t errors = LPC_GPDMA->INTERRSTAT;
+	uint32_t mask;
+	uint8_t channel;
+
+	LPC_GPDMA->INTTCCLEAR = pending;
+	LPC_GPDMA->INTERRCLR = errors;
+
+	for (channel = 0; channel < OS_DMA_NUMBER_OF_CHANNELS; channel++)
+	{
+		mask = (1UL << channel);
+		if ((pending & mask) && (NULL != os_dma_channels[channel].callback))
+		{
+			os_dma_channels[channel].callback(channel, (0 != (errors & mask)),
+					os_dma_channels[channel].param);
+		}
+	}
+}
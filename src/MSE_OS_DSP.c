@@ -0,0 +1,172 @@
+/*
+ * MSE_OS_DSP.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Rutinas de procesamiento de bloques de muestras q15 que
+ *         aprovechan las instrucciones SIMD del Cortex-M4
+ */
+
+/* El M0APP no tiene instrucciones SIMD */
+#if !defined(CORE_M0)
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_DSP.h"
+#include <string.h>
+
+/*==================[macros and definitions]=================================*/
+#define OS_DSP_ADC_VALUE(reg)	(((reg) >> 6) & 0x3FF)
+#define OS_DSP_ADC_MIDSCALE		512
+
+/*==================[Static headers]=========================================*/
+
+static uint32_t os_dsp_read2(const int16_t * src);
+static void os_dsp_write2(int16_t * dst, uint32_t value);
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_DSP.h)
+ *****************************************************************************/
+void os_dsp_adcToQ15(int16_t * dst, const uint32_t * src, uint32_t n)
+{
+	uint8_t * dstBytes = (uint8_t *)dst;
+	const uint8_t * srcBytes = (const uint8_t *)src;
+	uint32_t reg;
+	int16_t sample;
+	uint32_t i;
+
+	/* Se recorre hacia adelante: la muestra i se escribe en el byte 2i y la
+	 * lectura i está en el byte 4i, que todavía no fue sobrescrito. Al
+	 * trabajar en el lugar la misma memoria se ve como uint32_t e int16_t:
+	 * los accesos se hacen con memcpy para no violar el strict aliasing
+	 * (cada uno se traduce en un único LDR o STRH) */
+	for (i = 0; i < n; i++)
+	{
+		memcpy(&reg, &srcBytes[i * sizeof(uint32_t)], sizeof(reg));
+		sample = (int16_t)(((int32_t)OS_DSP_ADC_VALUE(reg) - OS_DSP_ADC_MIDSCALE) << 6);
+		memcpy(&dstBytes[i * sizeof(int16_t)], &sample, sizeof(sample));
+	}
+}
+
+void os_dsp_offset_q15(int16_t * block, uint32_t n, int16_t offset)
+{
+	uint32_t packedOffset = ((uint32_t)(uint16_t)offset << 16) | (uint16_t)offset;
+	uint32_t i;
+
+	for (i = 0; i < n; i += 2)
+	{
+		os_dsp_write2(&block[i], __QADD16(os_dsp_read2(&block[i]), packedOffset));
+	}
+}
+
+uint32_t os_dsp_decimate2_q15(int16_t * block, uint32_t n)
+{
+	uint32_t a, b;
+	uint32_t i;
+
+	for (i = 0; i < n; i += 4)
+	{
+		a = os_dsp_read2(&block[i]);		/* x1 | x0 */
+		b = os_dsp_read2(&block[i + 2]);	/* x3 | x2 */
+
+		/* (x0 + x1) / 2 y (x2 + x3) / 2 en una sola instrucción */
+		os_dsp_write2(&block[i / 2], __SHADD16(__PKHBT(a, b, 16), __PKHTB(b, a, 16)));
+	}
+
+	return (n / 2);
+}
+
+bool os_dsp_fir_init_q15(os_dsp_fir_q15_t * fir, const int16_t * coeffs,
+		uint16_t numTaps, uint8_t decimation, int16_t * state)
+{
+	/* El lazo SIMD toma los coeficientes de a pares */
+	bool result = ((0 < numTaps) && (0 == (numTaps % 2)));
+
+	fir->coeffs = coeffs;
+	fir->numTaps = result ? numTaps : 0;
+	fir->decimation = (0 == decimation) ? 1 : decimation;
+	fir->state = state;
+
+	if (result)
+	{
+		memset(state, 0, (numTaps - 1) * sizeof(int16_t));
+	}
+
+	return result;
+}
+
+uint32_t os_dsp_fir_q15(os_dsp_fir_q15_t * fir, int16_t * block, uint32_t n)
+{
+	const uint32_t history = fir->numTaps - 1;
+	const int16_t * window;
+	uint64_t acc;
+	uint32_t outputs = 0;
+	uint32_t i;
+	uint16_t k;
+
+	/* Filtro rechazado por os_dsp_fir_init_q15 */
+	if (0 == fir->numTaps)
+	{
+		n = 0;
+	}
+
+	/* Las muestras nuevas se agregan detrás de la historia, lo que permite
+	 * escribir el resultado sobre el mismo bloque */
+	memcpy(&fir->state[history], block, n * sizeof(int16_t));
+
+	for (i = 0; i < n; i += fir->decimation)
+	{
+		window = &fir->state[i];
+		acc = 0;
+		for (k = 0; k < fir->numTaps; k += 2)
+		{
+			acc = __SMLALD(os_dsp_read2(&window[k]), os_dsp_read2(&fir->coeffs[k]), acc);
+		}
+		block[outputs++] = (int16_t)__SSAT((int32_t)((int64_t)acc >> 15), 16);
+	}
+
+	/* Conservar las últimas muestras como historia del próximo bloque */
+	if (0 < n)
+	{
+		memmove(fir->state, &fir->state[n], history * sizeof(int16_t));
+	}
+
+	return (outputs);
+}
+
+/******************************************************************************
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief Lee dos muestras q15 consecutivas en una palabra.
+ *
+ *  @details
+ *   El Cortex-M4 admite lecturas de 32 bits no alineadas, y memcpy de 4
+ *   bytes se traduce en una única instrucción LDR.
+ *
+ *  @param *src					primera muestra
+ *  @return     muestras empaquetadas (la primera en la parte baja).
+******************************************************************************/
+static uint32_t os_dsp_read2(const int16_t * src)
+{
+	uint32_t value;
+
+	memcpy(&value, src, sizeof(value));
+
+	return (value);
+}
+
+/******************************************************************************
+ *  @brief Escribe dos muestras q15 consecutivas.
+ *
+ *  @param *dst					primera muestra
+ *  @param value				muestras empaquetadas
+ *  @return     none.
+******************************************************************************/
+static void os_dsp_write2(int16_t * dst, uint32_t value)
+{
+	memcpy(dst, &value, sizeof(value));
+}
+
+#endif
@@ -0,0 +1,275 @@
+/*
+ * MSE_OS_IPC.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Librería que contiene la comunicación entre el núcleo M4
+ *         y el co-procesador M0APP del LPC4337
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_IPC.h"
+#include "board.h"
+
+#if !defined(CORE_M0)
+#include "MSE_OS_IRQ.h"
+#endif
+
+/*==================[macros and definitions]=================================*/
+#define OS_IPC_SHARED		((os_ipcShared_t *) OS_CONFIG_IPC_SHARED_ADDRESS)
+
+/*==================[Static headers]=========================================*/
+
+static void os_ipc_signal(void);
+static void os_ipc_drainRing(void);
+
+#if !defined(CORE_M0)
+static void os_ipc_IRQHandler(void);
+#endif
+
+/*==================[Private data declaration]==============================*/
+
+#if defined(CORE_M0)
+static os_m0_queue_t * os_ipc_rxQueue;
+#else
+static os_Queue_t * os_ipc_rxQueue;
+static os_TaskHandler_t * os_ipc_txWaitingTasks;	/* lista de espera para enviar */
+#endif
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_IPC.h)
+ *****************************************************************************/
+
+#if defined(CORE_M0)
+
+/******************************************************************************
+ *	Lado M0APP
+ ******************************************************************************/
+void os_ipc_init(os_m0_queue_t * rxQueue)
+{
+	/* El M4 inicializa la memoria compartida antes de arrancar al M0APP */
+	while (OS_IPC_MAGIC != OS_IPC_SHARED->magic);
+
+	os_ipc_rxQueue = rxQueue;
+
+	NVIC_ClearPendingIRQ(M4_IRQn);
+	NVIC_EnableIRQ(M4_IRQn);
+
+	/* Mensajes que el M4 envió antes de habilitar la interrupción */
+	__disable_irq();
+	os_ipc_drainRing();
+	__enable_irq();
+}
+
+bool os_ipc_send(const os_ipcMessage_t * msg)
+{
+	bool sent = os_ipc_ringPut(&OS_IPC_SHARED->m0ToM4, msg);
+
+	if (sent)
+	{
+		os_ipc_signal();
+	}
+
+	return sent;
+}
+
+bool os_ipc_receive(os_ipcMessage_t * msg)
+{
+	bool received = os_m0_queue_remove(os_ipc_rxQueue, msg);
+	uint32_t primask;
+
+	/* Puede haber mensajes que quedaron en el ring porque la cola estaba llena */
+	primask = __get_PRIMASK();
+	__disable_irq();
+	os_ipc_drainRing();
+	__set_PRIMASK(primask);
+
+	return received;
+}
+
+/******************************************************************************
+ *  @brief Handler de la interrupción que genera el M4 al ejecutar SEV.
+ *
+ *  @details
+ *   Entrega los mensajes recibidos en la cola, lo que despierta a la
+ *   tarea de recepción.
+ *
+ *  @return     none.
+******************************************************************************/
+void M4_IRQHandler(void)
+{
+	LPC_CREG->M4TXEVENT = 0;
+
+	os_ipc_drainRing();
+}
+
+#else
+
+/******************************************************************************
+ *	Lado M4
+ ******************************************************************************/
+void os_ipc_init(os_Queue_t * rxQueue)
+{
+	os_ipc_ringInit(&OS_IPC_SHARED->m4ToM0);
+	os_ipc_ringInit(&OS_IPC_SHARED->m0ToM4);
+
+	/* Los rings deben quedar inicializados antes de que el M0APP vea el magic */
+	__DMB();
+	OS_IPC_SHARED->magic = OS_IPC_MAGIC;
+
+	os_ipc_rxQueue = rxQueue;
+	os_ipc_txWaitingTasks = NULL;
+
+	os_insertIRQ(M0APP_IRQn, os_ipc_IRQHandler);
+}
+
+void os_ipc_startM0(uint32_t imageAddress)
+{
+	Chip_RGU_TriggerReset(RGU_M0APP_RST);
+	Chip_Clock_Enable(CLK_M4_M0APP);
+	Chip_CREG_SetM0AppMemMap(imageAddress);
+	Chip_RGU_ClearReset(RGU_M0APP_RST);
+}
+
+bool os_ipc_send(const os_ipcMessage_t * msg)
+{
+	os_ipcRing_t * ring = &OS_IPC_SHARED->m4ToM0;
+	bool fromIrq = (os_control_state__running_from_IRQ == os_get_controlState());
+	bool sent;
+
+	/* El ring admite un solo productor: del lado del M4 todas las escrituras
+	 * (de tareas y de interrupciones) se serializan en la sección crítica */
+	os_enter_critical_zone();
+	sent = os_ipc_ringPut(ring, msg);
+
+	/* Desde una interrupción no se bloquea: si el ring está lleno se descarta.
+	 * El reintento también se hace dentro de la sección crítica: si el M0APP
+	 * libera lugar después, la interrupción queda pendiente y despierta a una
+	 * tarea de la lista al salir de la sección crítica */
+	while (!sent && !fromIrq)
+	{
+		os_blockActualTaskOnList(&os_ipc_txWaitingTasks, OS_WAIT_FOREVER);
+		os_exit_critical_zone();
+		os_CpuYield();
+		os_enter_critical_zone();
+		sent = os_ipc_ringPut(ring, msg);
+	}
+
+	if (sent)
+	{
+		os_ipc_signal();
+
+		/* Si el M0APP liberó más de un lugar, la siguiente tarea en espera
+		 * también puede enviar */
+		if (!os_ipc_ringIsFull(ring))
+		{
+			os_wakeUpFirstWaitingTask(&os_ipc_txWaitingTasks);
+		}
+	}
+	os_exit_critical_zone();
+
+	return sent;
+}
+
+void os_ipc_receive(os_ipcMessage_t * msg)
+{
+	os_queue_remove(os_ipc_rxQueue, msg);
+
+	/* Puede haber mensajes que quedaron en el ring porque la cola estaba llena */
+	os_enter_critical_zone();
+	os_ipc_drainRing();
+	os_exit_critical_zone();
+}
+
+#endif
+
+/******************************************************************************
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief Notifica al otro núcleo.
+ *
+ *  @details
+ *   SEV genera la interrupción entre núcleos en el otro núcleo. La barrera
+ *   asegura que las escrituras en el ring sean visibles antes del evento.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_ipc_signal(void)
+{
+	__DSB();
+	__SEV();
+}
+
+/******************************************************************************
+ *  @brief Pasa los mensajes del ring de recepción a la cola de recepción.
+ *
+ *  @details
+ *   Solo se leen del ring tantos mensajes como entren en la cola, para que
+ *   la inserción nunca bloquee. Si el ring estaba lleno se notifica al otro
+ *   núcleo que vuelve a haber lugar. Debe llamarse desde la interrupción o
+ *   dentro de una sección crítica.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_ipc_drainRing(void)
+{
+	os_ipcMessage_t msg;
+#if defined(CORE_M0)
+	os_ipcRing_t * ring = &OS_IPC_SHARED->m4ToM0;
+#else
+	os_ipcRing_t * ring = &OS_IPC_SHARED->m0ToM4;
+#endif
+	bool wasFull = os_ipc_ringIsFull(ring);
+	bool received = false;
+
+#if defined(CORE_M0)
+	while (!os_m0_queue_isFull(os_ipc_rxQueue) && os_ipc_ringGet(ring, &msg))
+	{
+		os_m0_queue_insert(os_ipc_rxQueue, &msg);
+		received = true;
+	}
+#else
+	while ((os_ipc_rxQueue->queueSize < os_ipc_rxQueue->maxElements) &&
+			os_ipc_ringGet(ring, &msg))
+	{
+		os_queue_insert(os_ipc_rxQueue, &msg);
+		received = true;
+	}
+#endif
+
+	if (received && wasFull)
+	{
+		os_ipc_signal();
+	}
+}
+
+#if !defined(CORE_M0)
+
+/******************************************************************************
+ *  @brief Handler de la interrupción que genera el M0APP al ejecutar SEV.
+ *
+ *  @details
+ *   Entrega los mensajes recibidos y, si el M0APP liberó lugar en el ring
+ *   de envío, despierta a la tarea más prioritaria de las que esperan para
+ *   enviar.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_ipc_IRQHandler(void)
+{
+	LPC_CREG->M0APPTXEVENT = 0;
+
+	os_ipc_drainRing();
+
+	/* Cada tarea despertada que logra enviar despierta a la siguiente
+	 * mientras siga habiendo lugar (os_ipc_send) */
+	if (!os_ipc_ringIsFull(&OS_IPC_SHARED->m4ToM0))
+	{
+		os_wakeUpFirstWaitingTask(&os_ipc_txWaitingTasks);
+	}
+}
+
+#endif
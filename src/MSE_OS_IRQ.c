@@ -66,7 +66,7 @@ bool os_removeIRQ(LPC43XX_IRQn_Type irq)
  *  @param IRQn					ID de interrupción.
  *  @return     True si tuvo éxito.
 ******************************************************************************/
-static void os_IRQHandler(LPC43XX_IRQn_Type IRQn)
+static OS_RAMFUNC void os_IRQHandler(LPC43XX_IRQn_Type IRQn)
 {
 	void (*user_IRQ_handler)(void);
 
@@ -95,12 +95,12 @@ static void os_IRQHandler(LPC43XX_IRQn_Type IRQn)
 	 * la misma interrupción*/
 	NVIC_ClearPendingIRQ(IRQn);
 
-	 /* Si hubo alguna llamada desde una interrupcion a una api liberando un evento, entonces
-	 * llamamos al scheduler
+	 /* Si hubo alguna llamada desde una interrupcion a una api liberando un evento, solo
+	 * se pende PendSV. El scheduler corre una sola vez cuando PendSV se encadene luego
+	 * de la ultima interrupcion (anidada o consecutiva), y no una vez por interrupcion
 	 */
 	if (os_isSchedulingFromIRQ())  {
-		os_clearSchedulingFromIRQ();
-		os_CpuYield();
+		os_pendSchedulingFromIRQ();
 	}
 }
 
@@ -0,0 +1,69 @@
+/*
+ * MSE_OS_IpcRing.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Rings lock-free de un productor y un consumidor utilizados
+ *         por la comunicación entre núcleos (MSE_OS_IPC.h)
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_IpcRing.h"
+#include "board.h"
+
+/*==================[macros and definitions]=================================*/
+#define OS_IPC_RING_MASK	(OS_CONFIG_IPC_RING_SIZE - 1)
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_IpcRing.h)
+ *****************************************************************************/
+
+void os_ipc_ringInit(os_ipcRing_t * ring)
+{
+	ring->head = 0;
+	ring->tail = 0;
+}
+
+bool os_ipc_ringPut(os_ipcRing_t * ring, const os_ipcMessage_t * msg)
+{
+	uint32_t head = ring->head;
+	bool result = false;
+
+	if ((head - ring->tail) < OS_CONFIG_IPC_RING_SIZE)
+	{
+		ring->buffer[head & OS_IPC_RING_MASK] = *msg;
+
+		/* El mensaje debe quedar escrito antes de que el otro núcleo vea el nuevo head */
+		__DMB();
+		ring->head = head + 1;
+		result = true;
+	}
+
+	return result;
+}
+
+bool os_ipc_ringGet(os_ipcRing_t * ring, os_ipcMessage_t * msg)
+{
+	uint32_t tail = ring->tail;
+	bool result = false;
+
+	if (tail != ring->head)
+	{
+		/* Leer el mensaje recién después de haber observado el head */
+		__DMB();
+		*msg = ring->buffer[tail & OS_IPC_RING_MASK];
+
+		/* Terminar de leer el mensaje antes de liberar su posición al productor */
+		__DMB();
+		ring->tail = tail + 1;
+		result = true;
+	}
+
+	return result;
+}
+
+bool os_ipc_ringIsFull(os_ipcRing_t * ring)
+{
+	return ((ring->head - ring->tail) >= OS_CONFIG_IPC_RING_SIZE);
+}
@@ -0,0 +1,261 @@
+/*
+ * MSE_OS_Log.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Librería de logging binario diferido
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_Log.h"
+#include "board.h"
+#include <stdio.h>
+
+#if !defined(CORE_M0)
+#include "MSE_OS_Core.h"
+#endif
+
+/*==================[macros and definitions]=================================*/
+#define OS_LOG_MASK				(OS_CONFIG_LOG_BUFFER_WORDS - 1)
+#define OS_LOG_HEADER_WORDS		2		/** encabezado + timestamp */
+
+/* Encabezado: marca de registro completo | cantidad de argumentos | ID de formato.
+ * Un encabezado en cero indica que el registro todavía no fue completado: el
+ * lector deja en cero todo el espacio que libera (os_log_readRecord) */
+#define OS_LOG_COMMIT_MARK		0xA5000000UL
+#define OS_LOG_MARK_MASK		0xFF000000UL
+#define OS_LOG_HEADER(id, n)	(OS_LOG_COMMIT_MARK | ((uint32_t)(n) << 16) | (id))
+#define OS_LOG_HEADER_ID(h)		((uint16_t)((h) & 0xFFFF))
+#define OS_LOG_HEADER_NARGS(h)	((uint8_t)(((h) >> 16) & 0xFF))
+
+typedef struct
+{
+	volatile uint32_t head;		/** próxima palabra a reservar (productores) */
+	volatile uint32_t tail;		/** próxima palabra a leer (lector) */
+	volatile uint32_t dropped;
+	const char * const * formats;
+	uint16_t numberOfFormats;
+	volatile uint32_t buffer[OS_CONFIG_LOG_BUFFER_WORDS];
+} os_log_t;
+
+/*==================[Static headers]=========================================*/
+
+static bool os_log_reserve(uint32_t words, uint32_t * position);
+static void os_log_countDropped(void);
+static uint32_t os_log_timestamp(void);
+
+/*==================[Private data declaration]==============================*/
+
+static os_log_t os_log;
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_Log.h)
+ *****************************************************************************/
+void os_log_init(const char * const * formats, uint16_t numberOfFormats)
+{
+	uint32_t i;
+
+	for (i = 0; i < OS_CONFIG_LOG_BUFFER_WORDS; i++)
+	{
+		os_log.buffer[i] = 0;
+	}
+	os_log.head = 0;
+	os_log.tail = 0;
+	os_log.dropped = 0;
+	os_log.formats = formats;
+	os_log.numberOfFormats = numberOfFormats;
+}
+
+void os_log_record(uint16_t formatId, uint8_t nArgs,
+		uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3)
+{
+	uint32_t args[OS_LOG_MAX_ARGS] = {a0, a1, a2, a3};
+	uint32_t position;
+	uint8_t i;
+
+	if (nArgs > OS_LOG_MAX_ARGS)
+	{
+		nArgs = OS_LOG_MAX_ARGS;
+	}
+
+	if (os_log_reserve(OS_LOG_HEADER_WORDS + nArgs, &position))
+	{
+		os_log.buffer[(position + 1) & OS_LOG_MASK] = os_log_timestamp();
+		for (i = 0; i < nArgs; i++)
+		{
+			os_log.buffer[(position + OS_LOG_HEADER_WORDS + i) & OS_LOG_MASK] = args[i];
+		}
+
+		/* El encabezado se escribe último: recién entonces el lector puede
+		 * consumir el registro */
+		__DMB();
+		os_log.buffer[position & OS_LOG_MASK] = OS_LOG_HEADER(formatId, nArgs);
+	}
+	else
+	{
+		os_log_countDropped();
+	}
+}
+
+bool os_log_readRecord(os_logRecord_t * record)
+{
+	uint32_t tail = os_log.tail;
+	uint32_t header = 0;
+	uint8_t i;
+	bool result = false;
+
+	if (tail != os_log.head)
+	{
+		header = os_log.buffer[tail & OS_LOG_MASK];
+	}
+
+	/* Si el registro más antiguo todavía se está escribiendo, los siguientes
+	 * esperan aunque ya estén completos para conservar el orden */
+	if (OS_LOG_COMMIT_MARK == (header & OS_LOG_MARK_MASK))
+	{
+		__DMB();
+		record->formatId = OS_LOG_HEADER_ID(header);
+		record->nArgs = OS_LOG_HEADER_NARGS(header);
+		record->timestamp = os_log.buffer[(tail + 1) & OS_LOG_MASK];
+		for (i = 0; i < OS_LOG_MAX_ARGS; i++)
+		{
+			record->args[i] = (i < record->nArgs) ?
+					os_log.buffer[(tail + OS_LOG_HEADER_WORDS + i) & OS_LOG_MASK] : 0;
+		}
+
+		/* Todas las palabras del registro se limpian antes de liberar el
+		 * espacio: cualquiera de ellas puede quedar como encabezado de un
+		 * registro futuro, y un timestamp o argumento viejo con la marca en
+		 * el byte alto haría parecer completo a un registro no terminado */
+		for (i = 0; i < (OS_LOG_HEADER_WORDS + record->nArgs); i++)
+		{
+			os_log.buffer[(tail + i) & OS_LOG_MASK] = 0;
+		}
+		__DMB();
+		os_log.tail = tail + OS_LOG_HEADER_WORDS + record->nArgs;
+		result = true;
+	}
+
+	return result;
+}
+
+bool os_log_format(char * buffer, size_t size)
+{
+	os_logRecord_t record;
+	const char * format;
+	bool result = os_log_readRecord(&record);
+
+	if (result)
+	{
+		if (record.formatId < os_log.numberOfFormats)
+		{
+			format = os_log.formats[record.formatId];
+			snprintf(buffer, size, format,
+					record.args[0], record.args[1], record.args[2], record.args[3]);
+		}
+		else
+		{
+			snprintf(buffer, size, "[log] formato desconocido %u\n\r",
+					(unsigned int)record.formatId);
+		}
+	}
+
+	return result;
+}
+
+uint32_t os_log_getDropped(void)
+{
+	return os_log.dropped;
+}
+
+/******************************************************************************
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief Reserva espacio para un registro.
+ *
+ *  @details
+ *   En el M4 la reserva es lock-free: si otra tarea o interrupción modificó
+ *   el head entre LDREX y STREX, se reintenta. El M0 no tiene exclusivos,
+ *   por lo que allí la reserva se hace con las interrupciones deshabilitadas
+ *   durante unas pocas instrucciones.
+ *
+ *  @param words				palabras a reservar
+ *  @param *position			primera palabra reservada
+ *  @return     true si había espacio.
+******************************************************************************/
+static bool os_log_reserve(uint32_t words, uint32_t * position)
+{
+	uint32_t head;
+	bool result;
+
+#if defined(CORE_M0)
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	head = os_log.head;
+	result = ((head - os_log.tail + words) <= OS_CONFIG_LOG_BUFFER_WORDS);
+	if (result)
+	{
+		os_log.head = head + words;
+	}
+	__set_PRIMASK(primask);
+#else
+	do
+	{
+		head = __LDREXW(&os_log.head);
+		result = ((head - os_log.tail + words) <= OS_CONFIG_LOG_BUFFER_WORDS);
+		if (!result)
+		{
+			__CLREX();
+		}
+	} while (result && __STREXW(head + words, &os_log.head));
+#endif
+
+	*position = head;
+
+	return result;
+}
+
+/******************************************************************************
+ *  @brief Incrementa el contador de eventos descartados.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_log_countDropped(void)
+{
+#if defined(CORE_M0)
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	os_log.dropped++;
+	__set_PRIMASK(primask);
+#else
+	uint32_t dropped;
+
+	do
+	{
+		dropped = __LDREXW(&os_log.dropped);
+	} while (__STREXW(dropped + 1, &os_log.dropped));
+#endif
+}
+
+/******************************************************************************
+ *  @brief Timestamp de los registros.
+ *
+ *  @details
+ *   El scheduler mínimo del M0 no lleva la cuenta de ticks, por lo que allí
+ *   los registros no tienen timestamp.
+ *
+ *  @return     ticks del sistema.
+******************************************************************************/
+static uint32_t os_log_timestamp(void)
+{
+#if defined(CORE_M0)
+	return 0;
+#else
+	return os_get_systemClockMs();
+#endif
+}
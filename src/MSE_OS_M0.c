@@ -0,0 +1,150 @@
+/*
+ * MSE_OS_M0.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Scheduler mínimo para el co-procesador Cortex-M0 (M0APP)
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_M0.h"
+
+#if defined(CORE_M0)
+
+#include "board.h"
+#include <string.h>
+
+/*==================[Private data declaration]==============================*/
+
+static os_m0_taskHandler_t os_m0_tasks[OS_CONFIG_M0_MAX_TASKS];
+static volatile uint32_t os_m0_readyTasks;	/** bit n: la tarea de prioridad n está despierta */
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_M0.h)
+ *****************************************************************************/
+
+bool os_m0_addTask(uint8_t priority, os_m0_taskHandler_t handler)
+{
+	bool result = false;
+
+	if ((priority < OS_CONFIG_M0_MAX_TASKS) && (NULL == os_m0_tasks[priority]))
+	{
+		os_m0_tasks[priority] = handler;
+		result = true;
+	}
+
+	return result;
+}
+
+void os_m0_signalTask(uint8_t priority)
+{
+	uint32_t primask;
+
+	/* El Cortex-M0 no tiene LDREX/STREX: el read-modify-write se protege
+	 * deshabilitando las interrupciones */
+	primask = __get_PRIMASK();
+	__disable_irq();
+	os_m0_readyTasks |= (1UL << priority);
+	__set_PRIMASK(primask);
+}
+
+void os_m0_run(void)
+{
+	uint8_t priority;
+	uint32_t ready;
+
+	while (1)
+	{
+		__disable_irq();
+		ready = os_m0_readyTasks;
+		if (0 == ready)
+		{
+			/* WFI con las interrupciones deshabilitadas: una interrupción pendiente
+			 * despierta al núcleo igual, y no se pierde una señal que llegue entre
+			 * la consulta y el WFI */
+			__WFI();
+			__enable_irq();
+		}
+		else
+		{
+			/* El Cortex-M0 no tiene CLZ: se busca el primer bit activo */
+			priority = 0;
+			while (0 == (ready & (1UL << priority)))
+			{
+				priority++;
+			}
+			os_m0_readyTasks &= ~(1UL << priority);
+			__enable_irq();
+
+			if (NULL != os_m0_tasks[priority])
+			{
+				os_m0_tasks[priority]();
+			}
+		}
+	}
+}
+
+void os_m0_queue_init(os_m0_queue_t * queue, void * storage, uint16_t elementSize,
+		uint16_t maxElements, uint8_t taskPriority)
+{
+	queue->storage = storage;
+	queue->elementSize = elementSize;
+	queue->maxElements = maxElements;
+	queue->head = 0;
+	queue->tail = 0;
+	queue->size = 0;
+	queue->taskToSignal = taskPriority;
+}
+
+bool os_m0_queue_insert(os_m0_queue_t * queue, const void * data)
+{
+	uint32_t primask;
+	bool result = false;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (queue->size < queue->maxElements)
+	{
+		memcpy(queue->storage + (uint32_t)queue->head * queue->elementSize,
+				data, queue->elementSize);
+		queue->head = (queue->head + 1) % queue->maxElements;
+		queue->size++;
+		result = true;
+	}
+	__set_PRIMASK(primask);
+
+	if (result)
+	{
+		os_m0_signalTask(queue->taskToSignal);
+	}
+
+	return result;
+}
+
+bool os_m0_queue_remove(os_m0_queue_t * queue, void * data)
+{
+	uint32_t primask;
+	bool result = false;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (0 < queue->size)
+	{
+		memcpy(data, queue->storage + (uint32_t)queue->tail * queue->elementSize,
+				queue->elementSize);
+		queue->tail = (queue->tail + 1) % queue->maxElements;
+		queue->size--;
+		result = true;
+	}
+	__set_PRIMASK(primask);
+
+	return result;
+}
+
+bool os_m0_queue_isFull(os_m0_queue_t * queue)
+{
+	return (queue->size >= queue->maxElements);
+}
+
+#endif /* CORE_M0 */
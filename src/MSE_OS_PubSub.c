@@ -0,0 +1,182 @@
+/*
+ * MSE_OS_PubSub.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Bus de eventos publicador/suscriptor sin copias
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_PubSub.h"
+#include <stddef.h>
+
+/*==================[macros and definitions]=================================*/
+#define OS_PUBSUB_MESSAGE_WORDS	((OS_PUBSUB_MESSAGE_SIZE + 3) / 4)
+
+typedef struct os_PubSubMessage
+{
+	struct os_PubSubMessage * nextFree;
+	uint8_t refCount;
+	uint32_t payload[OS_PUBSUB_MESSAGE_WORDS];	/** alineado a 4 bytes */
+} os_PubSubMessage_t;
+
+#define OS_PUBSUB_HEADER(message)	\
+	((os_PubSubMessage_t *)((uint8_t *)(message) - offsetof(os_PubSubMessage_t, payload)))
+
+/*==================[Static headers]=========================================*/
+
+static bool os_pubsub_deliver(os_Subscriber_t * subscriber, void * message);
+
+/*==================[Private data declaration]==============================*/
+
+static os_PubSubMessage_t os_pubsub_pool[OS_PUBSUB_POOL_SIZE];
+static os_PubSubMessage_t * os_pubsub_freeList;
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_PubSub.h)
+ *****************************************************************************/
+void os_pubsub_init(void)
+{
+	uint16_t i;
+
+	os_pubsub_freeList = NULL;
+	for (i = 0; i < OS_PUBSUB_POOL_SIZE; i++)
+	{
+		os_pubsub_pool[i].refCount = 0;
+		os_pubsub_pool[i].nextFree = os_pubsub_freeList;
+		os_pubsub_freeList = &os_pubsub_pool[i];
+	}
+}
+
+void os_topic_init(os_Topic_t * topic)
+{
+	topic->subscribers = NULL;
+}
+
+void os_pubsub_subscribe(os_Topic_t * topic, os_Subscriber_t * subscriber,
+		os_PubSubPolicy_t policy)
+{
+	os_queue_init(&subscriber->queue, sizeof(void *));
+	subscriber->policy = policy;
+	subscriber->dropped = 0;
+
+	os_enter_critical_zone();
+	subscriber->next = topic->subscribers;
+	topic->subscribers = subscriber;
+	os_exit_critical_zone();
+}
+
+void * os_pubsub_alloc(void)
+{
+	os_PubSubMessage_t * message;
+	void * payload = NULL;
+
+	os_enter_critical_zone();
+	message = os_pubsub_freeList;
+	if (NULL != message)
+	{
+		os_pubsub_freeList = message->nextFree;
+		message->refCount = 1;
+		payload = message->payload;
+	}
+	os_exit_critical_zone();
+
+	return (payload);
+}
+
+uint8_t os_pubsub_publish(os_Topic_t * topic, void * message)
+{
+	os_Subscriber_t * subscriber;
+	uint8_t delivered = 0;
+
+	/* El publicador conserva su referencia (tomada en os_pubsub_alloc) hasta
+	 * terminar de repartir, para que un suscriptor más prioritario que libere
+	 * el mensaje enseguida no lo devuelva al pool antes de tiempo */
+	for (subscriber = topic->subscribers; NULL != subscriber; subscriber = subscriber->next)
+	{
+		if (os_pubsub_deliver(subscriber, message))
+		{
+			delivered++;
+		}
+	}
+
+	os_pubsub_release(message);
+
+	return (delivered);
+}
+
+const void * os_pubsub_receive(os_Subscriber_t * subscriber)
+{
+	/* Desde una interrupción os_queue_remove no espera: si la cola está
+	 * vacía no escribe el mensaje */
+	void * message = NULL;
+
+	os_queue_remove(&subscriber->queue, &message);
+
+	return (message);
+}
+
+void os_pubsub_release(const void * message)
+{
+	os_PubSubMessage_t * header = OS_PUBSUB_HEADER(message);
+
+	os_enter_critical_zone();
+	header->refCount--;
+	if (0 == header->refCount)
+	{
+		header->nextFree = os_pubsub_freeList;
+		os_pubsub_freeList = header;
+	}
+	os_exit_critical_zone();
+}
+
+/******************************************************************************
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief Entrega un mensaje a un suscriptor.
+ *
+ *  @details
+ *   Con la política de descarte la verificación de espacio y la inserción
+ *   se hacen en la misma sección crítica, por lo que la inserción nunca
+ *   bloquea. Con la política de bloqueo, la inserción espera a que el
+ *   suscriptor libere lugar en su cola.
+ *
+ *  @param *subscriber			suscriptor
+ *  @param *message				mensaje
+ *  @return     true si el mensaje fue entregado.
+******************************************************************************/
+static bool os_pubsub_deliver(os_Subscriber_t * subscriber, void * message)
+{
+	os_PubSubMessage_t * header = OS_PUBSUB_HEADER(message);
+	bool canBlock = (os_pubsub_policy__block == subscriber->policy) &&
+			(os_control_state__running_from_IRQ != os_get_controlState());
+	bool delivered = false;
+
+	os_enter_critical_zone();
+	if (subscriber->queue.queueSize < subscriber->queue.maxElements)
+	{
+		header->refCount++;
+		os_queue_insert(&subscriber->queue, &message);
+		delivered = true;
+	}
+	else if (canBlock)
+	{
+		header->refCount++;
+	}
+	else
+	{
+		subscriber->dropped++;
+	}
+	os_exit_critical_zone();
+
+	if (!delivered && canBlock)
+	{
+		os_queue_insert(&subscriber->queue, &message);
+		delivered = true;
+	}
+
+	return (delivered);
+}
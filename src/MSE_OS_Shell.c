@@ -0,0 +1,314 @@
+/*
+ * MSE_OS_Shell.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Consola de diagnóstico del sistema operativo
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_Shell.h"
+#include "MSE_OS_API.h"
+#include <stdio.h>
+#include <string.h>
+
+/*==================[macros and definitions]=================================*/
+#define OS_SHELL_LINE_SIZE		32
+#define OS_SHELL_OUTPUT_SIZE	96
+
+typedef struct
+{
+	const char * name;
+	void (*handler)(void);
+} os_shellCommand_t;
+
+/*==================[Static headers]=========================================*/
+
+static void os_shell_execute(void);
+static void os_shell_print(void);
+static void os_shell_help(void);
+static void os_shell_tasks(void);
+static void os_shell_printTask(os_TaskHandler_t * task, uint32_t statsTicks);
+static void os_shell_queues(void);
+static void os_shell_error(void);
+static void os_shell_reset(void);
+#ifdef OS_CONFIG_PROFILE_CYCLES
+static void os_shell_cycles(void);
+#endif
+
+/*==================[Private data declaration]==============================*/
+
+static const os_shellCommand_t os_shell_commands[] =
+{
+	{"help", os_shell_help},
+	{"tasks", os_shell_tasks},
+	{"queues", os_shell_queues},
+	{"error", os_shell_error},
+	{"reset", os_shell_reset},
+#ifdef OS_CONFIG_PROFILE_CYCLES
+	{"cycles", os_shell_cycles},
+#endif
+};
+
+#define OS_SHELL_COMMANDS	(sizeof(os_shell_commands) / sizeof(os_shell_commands[0]))
+
+static const char * const os_shell_stateNames[] =
+{
+	[os_task_state__running] = "running",
+	[os_task_state__ready] = "ready",
+	[os_task_state__blocked] = "blocked",
+	[os_task_state__suspended] = "suspended",
+	[os_task_state__deleted] = "deleted",
+};
+
+static os_Uart_t * os_shell_port;
+static char os_shell_line[OS_SHELL_LINE_SIZE];
+static uint8_t os_shell_lineLength;
+static char os_shell_output[OS_SHELL_OUTPUT_SIZE];
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_Shell.h)
+ *****************************************************************************/
+void os_shell_init(os_Uart_t * port)
+{
+	os_shell_port = port;
+	os_shell_lineLength = 0;
+}
+
+void os_shell_poll(void)
+{
+	char received[OS_SHELL_LINE_SIZE];
+	uint16_t length;
+	uint16_t i;
+
+	do
+	{
+		length = os_uart_read(os_shell_port, received, sizeof(received), OS_NO_WAIT);
+
+		for (i = 0; i < length; i++)
+		{
+			if (('\r' == received[i]) || ('\n' == received[i]))
+			{
+				/* Un \r\n genera una línea vacía que se ignora */
+				if (0 < os_shell_lineLength)
+				{
+					os_shell_line[os_shell_lineLength] = '\0';
+					os_uart_write(os_shell_port, "\n\r", 2);
+					os_shell_execute();
+					os_shell_lineLength = 0;
+				}
+			}
+			else if (os_shell_lineLength < (OS_SHELL_LINE_SIZE - 1))
+			{
+				os_shell_line[os_shell_lineLength++] = received[i];
+				os_uart_write(os_shell_port, &received[i], 1);
+			}
+		}
+	} while (0 < length);
+}
+
+/******************************************************************************
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief Ejecuta el comando de la línea recibida.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_shell_execute(void)
+{
+	uint32_t i = 0;
+
+	while ((i < OS_SHELL_COMMANDS) &&
+			(0 != strcmp(os_shell_line, os_shell_commands[i].name)))
+	{
+		i++;
+	}
+
+	if (i < OS_SHELL_COMMANDS)
+	{
+		os_shell_commands[i].handler();
+	}
+	else
+	{
+		snprintf(os_shell_output, sizeof(os_shell_output),
+				"comando desconocido: %s\n\r", os_shell_line);
+		os_shell_print();
+	}
+}
+
+/******************************************************************************
+ *  @brief Envía el texto formateado en os_shell_output.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_shell_print(void)
+{
+	os_uart_write(os_shell_port, os_shell_output, strlen(os_shell_output));
+}
+
+/******************************************************************************
+ *  @brief Comando help.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_shell_help(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < OS_SHELL_COMMANDS; i++)
+	{
+		snprintf(os_shell_output, sizeof(os_shell_output), "%s\n\r",
+				os_shell_commands[i].name);
+		os_shell_print();
+	}
+}
+
+/******************************************************************************
+ *  @brief Comando tasks.
+ *
+ *  @details
+ *   El uso del CPU se expresa en décimas de por ciento de los ticks
+ *   transcurridos desde el último reset.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_shell_tasks(void)
+{
+	uint32_t statsTicks = os_getStatsTicks();
+	os_taskId_t i;
+
+	snprintf(os_shell_output, sizeof(os_shell_output),
+			"id  prio estado     cpu%%   stack libre\n\r");
+	os_shell_print();
+
+	for (i = 0; i < os_getTaskCount(); i++)
+	{
+		os_shell_printTask(os_getTask(i), statsTicks);
+	}
+	os_shell_printTask(os_getTask(OS_IDLE_TASK_ID), statsTicks);
+}
+
+/******************************************************************************
+ *  @brief Imprime una fila del comando tasks.
+ *
+ *  @param *task				tarea a mostrar
+ *  @param statsTicks			ticks desde el último reset de estadísticas
+ *  @return     none.
+******************************************************************************/
+static void os_shell_printTask(os_TaskHandler_t * task, uint32_t statsTicks)
+{
+	uint32_t permille = 0;
+	int length;
+
+	if (0 < statsTicks)
+	{
+		permille = (uint32_t)(((uint64_t)task->runTicks * 1000) / statsTicks);
+	}
+
+	length = snprintf(os_shell_output, sizeof(os_shell_output),
+			"%-3d %-4u %-10s %3lu.%lu  %lu",
+			(OS_IDLE_TASK_ID == task->taskID) ? -1 : (int)task->taskID,
+			(unsigned int)task->priority,
+			os_shell_stateNames[task->state],
+			(unsigned long)(permille / 10), (unsigned long)(permille % 10),
+			(unsigned long)os_getStackFreeBytes(task));
+
+#ifdef OS_CONFIG_EDF_PRIORITY
+	if (OS_CONFIG_EDF_PRIORITY == task->priority)
+	{
+		length += snprintf(os_shell_output + length, sizeof(os_shell_output) - length,
+				"  edf, deadlines perdidos: %lu", (unsigned long)os_getDeadlineMisses(task));
+	}
+#endif
+
+	snprintf(os_shell_output + length, sizeof(os_shell_output) - length, "\n\r");
+	os_shell_print();
+}
+
+/******************************************************************************
+ *  @brief Comando queues.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_shell_queues(void)
+{
+	os_Queue_t * queue = os_queue_getNext(NULL);
+	uint32_t i = 0;
+
+	snprintf(os_shell_output, sizeof(os_shell_output),
+			"cola  ocupada  pico  esperas\n\r");
+	os_shell_print();
+
+	while (NULL != queue)
+	{
+		snprintf(os_shell_output, sizeof(os_shell_output),
+				"%-5lu %3u/%-4u %-5u %lu\n\r",
+				(unsigned long)i,
+				(unsigned int)queue->queueSize, (unsigned int)queue->maxElements,
+				(unsigned int)queue->peakSize, (unsigned long)queue->waitCount);
+		os_shell_print();
+
+		queue = os_queue_getNext(queue);
+		i++;
+	}
+}
+
+/******************************************************************************
+ *  @brief Comando error.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_shell_error(void)
+{
+	snprintf(os_shell_output, sizeof(os_shell_output), "error: %u\n\r",
+			(unsigned int)os_getError());
+	os_shell_print();
+}
+
+/******************************************************************************
+ *  @brief Comando reset.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_shell_reset(void)
+{
+	os_Queue_t * queue = os_queue_getNext(NULL);
+
+	os_resetTaskStats();
+
+	while (NULL != queue)
+	{
+		os_queue_resetStats(queue);
+		queue = os_queue_getNext(queue);
+	}
+
+	snprintf(os_shell_output, sizeof(os_shell_output), "contadores reiniciados\n\r");
+	os_shell_print();
+}
+
+#ifdef OS_CONFIG_PROFILE_CYCLES
+/******************************************************************************
+ *  @brief Comando cycles.
+ *
+ *  @details
+ *   Muestra los ciclos de CPU del tick y del cambio de contexto medidos
+ *   por el kernel (última medición y máximo desde el último reset).
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_shell_cycles(void)
+{
+	os_kernelCycles_t cycles;
+
+	os_getKernelCycles(&cycles);
+
+	snprintf(os_shell_output, sizeof(os_shell_output),
+			"tick: %lu (max %lu)  scheduling en PendSV: %lu (max %lu) ciclos\n\r",
+			(unsigned long)cycles.tickLast, (unsigned long)cycles.tickMax,
+			(unsigned long)cycles.switchLast, (unsigned long)cycles.switchMax);
+	os_shell_print();
+}
+#endif
@@ -0,0 +1,196 @@
+/*
+ * MSE_OS_Sst.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Handlers de eventos run-to-completion sobre un único stack
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_Sst.h"
+
+/*==================[macros and definitions]=================================*/
+#define OS_SST_QUEUE_MASK	(OS_CONFIG_SST_QUEUE_SIZE - 1)
+
+/* El handler de prioridad 0 ocupa el bit 31 para obtenerlo con __CLZ */
+#define OS_SST_BIT(priority)	(0x80000000UL >> (priority))
+
+/* Prioridad en curso cuando no se está ejecutando ningún handler */
+#define OS_SST_NONE			OS_CONFIG_SST_PRIORITIES
+
+typedef struct
+{
+	os_sstHandler_t handler;
+	uint8_t head;
+	uint8_t tail;
+	uint32_t events[OS_CONFIG_SST_QUEUE_SIZE];
+} os_sstSlot_t;
+
+typedef struct
+{
+	os_sstSlot_t slots[OS_CONFIG_SST_PRIORITIES];
+	volatile uint32_t readySet;		/** handlers con eventos pendientes */
+	uint8_t currentPriority;		/** prioridad del handler en ejecución */
+	os_TaskHandler_t * hostTask;
+	os_TaskHandler_t * hostWaiting;
+} os_sst_t;
+
+/*==================[Static headers]=========================================*/
+
+static void os_sst_task(void);
+static void os_sst_schedule(void);
+
+/*==================[Private data declaration]==============================*/
+
+static os_sst_t os_sst;
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_Sst.h)
+ *****************************************************************************/
+os_TaskHandler_t * os_sst_init(uint8_t taskPriority)
+{
+	os_sst.readySet = 0;
+	os_sst.currentPriority = OS_SST_NONE;
+	os_sst.hostWaiting = NULL;
+	os_sst.hostTask = os_InitTask(os_sst_task, taskPriority);
+
+	return (os_sst.hostTask);
+}
+
+bool os_sst_register(uint8_t priority, os_sstHandler_t handler)
+{
+	bool result = false;
+
+	if ((priority < OS_CONFIG_SST_PRIORITIES) &&
+		(NULL == os_sst.slots[priority].handler))
+	{
+		os_sst.slots[priority].head = 0;
+		os_sst.slots[priority].tail = 0;
+		os_sst.slots[priority].handler = handler;
+		result = true;
+	}
+
+	return (result);
+}
+
+bool os_sst_post(uint8_t priority, uint32_t event)
+{
+	os_sstSlot_t * slot;
+	bool result = false;
+
+	if ((priority < OS_CONFIG_SST_PRIORITIES) &&
+		(NULL != os_sst.slots[priority].handler))
+	{
+		slot = &os_sst.slots[priority];
+		os_enter_critical_zone();
+		if ((uint8_t)(slot->head - slot->tail) < OS_CONFIG_SST_QUEUE_SIZE)
+		{
+			slot->events[slot->head & OS_SST_QUEUE_MASK] = event;
+			slot->head++;
+			os_sst.readySet |= OS_SST_BIT(priority);
+			result = true;
+		}
+		os_exit_critical_zone();
+	}
+
+	if (result)
+	{
+		/* Desde un handler, uno de mayor prioridad se ejecuta ya mismo como una
+		 * llamada anidada; en otro caso se despierta a la tarea anfitriona */
+		if ((os_control_state__running_from_IRQ != os_get_controlState()) &&
+			(os_getActualtask() == os_sst.hostTask))
+		{
+			os_sst_schedule();
+		}
+		else
+		{
+			os_wakeUpWaitingTask(&os_sst.hostWaiting);
+		}
+	}
+
+	return (result);
+}
+
+/******************************************************************************
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief Tarea anfitriona de los handlers.
+ *
+ *  @details
+ *   Ejecuta los handlers con eventos pendientes y se bloquea cuando no
+ *   queda ninguno.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_sst_task(void)
+{
+	bool blocked;
+
+	while (1)
+	{
+		os_enter_critical_zone();
+		blocked = (0 == os_sst.readySet);
+		if (blocked)
+		{
+			os_blockActualTaskOn(&os_sst.hostWaiting, OS_WAIT_FOREVER);
+		}
+		os_exit_critical_zone();
+
+		if (blocked)
+		{
+			os_CpuYield();
+		}
+
+		os_sst_schedule();
+	}
+}
+
+/******************************************************************************
+ *  @brief Ejecuta los handlers pendientes más prioritarios que el actual.
+ *
+ *  @details
+ *   Cada handler se ejecuta hasta terminar, con las interrupciones
+ *   habilitadas. Si durante su ejecución se publica un evento para un
+ *   handler más prioritario, esta rutina se vuelve a llamar de forma
+ *   anidada, por lo que la profundidad del stack compartido está acotada
+ *   por la cantidad de prioridades.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_sst_schedule(void)
+{
+	uint8_t preempted = os_sst.currentPriority;
+	uint8_t priority;
+	os_sstSlot_t * slot;
+	uint32_t event;
+	bool pending = true;
+
+	while (pending)
+	{
+		os_enter_critical_zone();
+		priority = (0 == os_sst.readySet) ? OS_SST_NONE : __CLZ(os_sst.readySet);
+		pending = (priority < preempted);
+		if (pending)
+		{
+			slot = &os_sst.slots[priority];
+			event = slot->events[slot->tail & OS_SST_QUEUE_MASK];
+			slot->tail++;
+			if (slot->tail == slot->head)
+			{
+				os_sst.readySet &= ~OS_SST_BIT(priority);
+			}
+			os_sst.currentPriority = priority;
+		}
+		os_exit_critical_zone();
+
+		if (pending)
+		{
+			slot->handler(event);
+		}
+	}
+
+	os_sst.currentPriority = preempted;
+}
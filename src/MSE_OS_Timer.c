@@ -0,0 +1,221 @@
+/*
+ * MSE_OS_Timer.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Esperas de alta resolución del sistema operativo
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_Timer.h"
+#include "MSE_OS_API.h"
+#include "MSE_OS_IRQ.h"
+
+/*==================[macros and definitions]=================================*/
+#define OS_TIMER_MATCH			0
+
+/** Un match programado a menos de este margen podría quedar atrás del
+ *  contador antes de escribirse, por lo que esos instantes se consideran
+ *  alcanzados */
+#define OS_TIMER_MIN_DELTA_US	2
+
+typedef struct
+{
+	LPC_TIMER_T * timer;
+	LPC43XX_IRQn_Type irq;
+	CHIP_CCU_CLK_T clock;
+} os_timer_hw_t;
+
+/** Tarea dormida; vive en el stack de la propia tarea */
+typedef struct os_timerSleeper
+{
+	uint64_t deadlineUs;
+	os_TaskHandler_t * task;
+	struct os_timerSleeper * next;
+} os_timerSleeper_t;
+
+/*==================[Static headers]=========================================*/
+
+static void os_timer_program(uint64_t now);
+static void os_timer_IRQHandler(void);
+
+/*==================[Private data declaration]==============================*/
+
+static const os_timer_hw_t os_timer_hw[] =
+{
+	{LPC_TIMER0, TIMER0_IRQn, CLK_MX_TIMER0},
+	{LPC_TIMER1, TIMER1_IRQn, CLK_MX_TIMER1},
+	{LPC_TIMER2, TIMER2_IRQn, CLK_MX_TIMER2},
+	{LPC_TIMER3, TIMER3_IRQn, CLK_MX_TIMER3},
+};
+
+#define OS_TIMER_HW		(&os_timer_hw[OS_CONFIG_HR_TIMER])
+
+/** Tareas dormidas ordenadas por instante de despertar */
+static os_timerSleeper_t * os_timer_sleepers;
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_Timer.h)
+ *****************************************************************************/
+void os_timer_init(void)
+{
+	LPC_TIMER_T * timer = OS_TIMER_HW->timer;
+
+	os_timer_sleepers = NULL;
+
+	Chip_TIMER_Init(timer);
+	Chip_TIMER_PrescaleSet(timer, (Chip_Clock_GetRate(OS_TIMER_HW->clock) / 1000000) - 1);
+	Chip_TIMER_Reset(timer);
+	Chip_TIMER_MatchDisableInt(timer, OS_TIMER_MATCH);
+	Chip_TIMER_Enable(timer);
+
+	os_insertIRQ(OS_TIMER_HW->irq, os_timer_IRQHandler);
+}
+
+void os_timer_sleepUntilUs(uint64_t deadlineUs)
+{
+	os_timerSleeper_t sleeper;
+	os_timerSleeper_t ** position;
+	uint64_t now = os_get_systemClockUs();
+	uint32_t usPerTick = os_get_tickPeriodUs();
+
+	/* La parte gruesa de la espera se hace por ticks, terminando al menos un
+	 * tick antes del instante pedido */
+	if ((deadlineUs > now) && ((deadlineUs - now) >= (2 * usPerTick)))
+	{
+		os_Delay((uint32_t)((deadlineUs - now) / usPerTick) - 1);
+	}
+
+	sleeper.deadlineUs = deadlineUs;
+	sleeper.task = os_getActualtask();
+
+	os_enter_critical_zone();
+	now = os_get_systemClockUs();
+	if ((deadlineUs > now) && ((deadlineUs - now) >= OS_TIMER_MIN_DELTA_US))
+	{
+		position = &os_timer_sleepers;
+		while ((NULL != *position) && ((*position)->deadlineUs <= deadlineUs))
+		{
+			position = &(*position)->next;
+		}
+		sleeper.next = *position;
+		*position = &sleeper;
+
+		if (&sleeper == os_timer_sleepers)
+		{
+			os_timer_program(now);
+		}
+
+		/* La interrupción saca a la tarea de la lista al despertarla: hasta
+		 * entonces cualquier otro despertar se ignora */
+		while (NULL != sleeper.task)
+		{
+			os_blockActualTask(OS_WAIT_FOREVER);
+			os_exit_critical_zone();
+			os_CpuYield();
+			os_enter_critical_zone();
+		}
+	}
+	os_exit_critical_zone();
+}
+
+void os_timer_sleepUs(uint32_t us)
+{
+	os_timer_sleepUntilUs(os_get_systemClockUs() + us);
+}
+
+void os_timer_removeTask(os_TaskHandler_t * task)
+{
+	os_timerSleeper_t ** position = &os_timer_sleepers;
+	os_timerSleeper_t * first;
+
+	os_enter_critical_zone();
+	first = os_timer_sleepers;
+	while ((NULL != *position) && (task != (*position)->task))
+	{
+		position = &(*position)->next;
+	}
+	if (NULL != *position)
+	{
+		*position = (*position)->next;
+
+		/* El match programado era el de la tarea eliminada */
+		if (first != os_timer_sleepers)
+		{
+			os_timer_program(os_get_systemClockUs());
+		}
+	}
+	os_exit_critical_zone();
+}
+
+/******************************************************************************
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief Programa el match para la primera tarea dormida.
+ *
+ *  @details
+ *   El timer y el reloj del sistema no comparten base de tiempo, por lo que
+ *   se programa la diferencia entre el instante pedido y el actual. Debe
+ *   llamarse dentro de una sección crítica o desde la interrupción.
+ *
+ *  @param now					instante actual de os_get_systemClockUs
+ *  @return     none.
+******************************************************************************/
+static void os_timer_program(uint64_t now)
+{
+	LPC_TIMER_T * timer = OS_TIMER_HW->timer;
+	uint64_t delta;
+
+	if (NULL == os_timer_sleepers)
+	{
+		Chip_TIMER_MatchDisableInt(timer, OS_TIMER_MATCH);
+	}
+	else
+	{
+		delta = (os_timer_sleepers->deadlineUs > now) ?
+				(os_timer_sleepers->deadlineUs - now) : 0;
+		if (delta < OS_TIMER_MIN_DELTA_US)
+		{
+			delta = OS_TIMER_MIN_DELTA_US;
+		}
+
+		Chip_TIMER_SetMatch(timer, OS_TIMER_MATCH,
+				Chip_TIMER_ReadCount(timer) + (uint32_t)delta);
+		Chip_TIMER_ClearMatch(timer, OS_TIMER_MATCH);
+		Chip_TIMER_MatchEnableInt(timer, OS_TIMER_MATCH);
+	}
+}
+
+/******************************************************************************
+ *  @brief Handler de la interrupción del timer.
+ *
+ *  @details
+ *   Despierta a todas las tareas cuyo instante ya se alcanzó y programa el
+ *   match para la siguiente.
+ *
+ *  @return     none.
+******************************************************************************/
+static void os_timer_IRQHandler(void)
+{
+	os_timerSleeper_t * sleeper;
+	os_TaskHandler_t * task;
+	uint64_t now = os_get_systemClockUs();
+
+	Chip_TIMER_ClearMatch(OS_TIMER_HW->timer, OS_TIMER_MATCH);
+
+	while ((NULL != os_timer_sleepers) &&
+			(os_timer_sleepers->deadlineUs < (now + OS_TIMER_MIN_DELTA_US)))
+	{
+		sleeper = os_timer_sleepers;
+		os_timer_sleepers = sleeper->next;
+
+		task = sleeper->task;
+		sleeper->task = NULL;
+		os_wakeUpWaitingTask(&task);
+	}
+
+	os_timer_program(now);
+}
@@ -0,0 +1,467 @@
+/*
+ * MSE_OS_Uart.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Driver de UART del sistema operativo basado en GPDMA
+ */
+
+/*==================[inclusions]=============================================*/
+#include "MSE_OS_Uart.h"
+#include "MSE_OS_DMA.h"
+#include "MSE_OS_IRQ.h"
+#include <string.h>
+
+/*==================[macros and definitions]=================================*/
+#define OS_UART_RX_HALF_SIZE	(OS_UART_RX_BUFFER_SIZE / 2)
+
+typedef struct
+{
+	LPC_USART_T * uart;
+	LPC43XX_IRQn_Type irq;
+	uint32_t txConnection;
+	uint32_t rxConnection;
+	void (*irqHandler)(void);
+} os_uart_hw_t;
+
+/*==================[Static headers]=========================================*/
+
+static void os_uart0_IRQHandler(void);
+static void os_uart1_IRQHandler(void);
+static void os_uart2_IRQHandler(void);
+static void os_uart3_IRQHandler(void);
+static void os_uart_IRQHandler(os_uart_id_t id);
+static void os_uart_txCallback(uint8_t channel, bool error, void * param);
+static void os_uart_rxCallback(uint8_t channel, bool error, void * param);
+static uint16_t os_uart_rxAvailable(os_Uart_t * port);
+static uint32_t os_uart_rxWritten(os_Uart_t * port, uint16_t * position);
+static void os_uart_rxDiscard(os_Uart_t * port, uint32_t written, uint16_t position);
+static void os_uart_rxStart(os_Uart_t * port);
+static void os_uart_setError(os_Uart_t * port, uint8_t error);
+
+/*==================[Private data declaration]==============================*/
+
+static const os_uart_hw_t os_uart_hw[os_uart_count] =
+{
+	{LPC_USART0, USART0_IRQn, GPDMA_CONN_UART0_Tx, GPDMA_CONN_UART0_Rx, os_uart0_IRQHandler},
+	{LPC_UART1,  UART1_IRQn,  GPDMA_CONN_UART1_Tx, GPDMA_CONN_UART1_Rx, os_uart1_IRQHandler},
+	{LPC_USART2, USART2_IRQn, GPDMA_CONN_UART2_Tx, GPDMA_CONN_UART2_Rx, os_uart2_IRQHandler},
+	{LPC_USART3, USART3_IRQn, GPDMA_CONN_UART3_Tx, GPDMA_CONN_UART3_Rx, os_uart3_IRQHandler},
+};
+
+static os_Uart_t * os_uart_ports[os_uart_count];
+
+/******************************************************************************
+ * Funciones públicas (descripción de las mimas en MSE_OS_Uart.h)
+ *****************************************************************************/
+bool os_uart_init(os_Uart_t * port, os_uart_id_t id, uint32_t baudRate)
+{
+	const os_uart_hw_t * hw;
+	bool result = false;
+
+	if ((id < os_uart_count) && (NULL == os_uart_ports[id]))
+	{
+		hw = &os_uart_hw[id];
+
+		port->id = id;
+		port->txBusy = false;
+		port->txError = false;
+		port->errors = 0;
+		port->rxErrorWakeUp = false;
+		port->txWaiting = NULL;
+		port->rxWaiting = NULL;
+
+		os_dma_init();
+		port->txChannel = os_dma_allocChannel(os_uart_txCallback, port);
+		port->rxChannel = os_dma_allocChannel(os_uart_rxCallback, port);
+
+		if ((OS_DMA_NO_CHANNEL != port->txChannel) &&
+				(OS_DMA_NO_CHANNEL != port->rxChannel))
+		{
+			Chip_UART_Init(hw->uart);
+			Chip_UART_SetBaud(hw->uart, baudRate);
+			Chip_UART_ConfigData(hw->uart, UART_LCR_WLEN8 | UART_LCR_SBS_1BIT | UART_LCR_PARITY_DIS);
+			Chip_UART_SetupFIFOS(hw->uart, UART_FCR_FIFO_EN | UART_FCR_RX_RS |
+					UART_FCR_TX_RS | UART_FCR_DMAMODE_SEL | UART_FCR_TRG_LEV2);
+			Chip_UART_TXEnable(hw->uart);
+
+			/* Recepción continua: cada mitad del buffer es un descriptor que
+			 * enlaza con el otro, e interrumpe al completarse */
+			Chip_GPDMA_InitDescriptor(LPC_GPDMA, &port->rxDescriptors[0], hw->rxConnection,
+					(uint32_t)(uintptr_t)&port->rxBuffer[0], OS_UART_RX_HALF_SIZE,
+					GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, &port->rxDescriptors[1]);
+			Chip_GPDMA_InitDescriptor(LPC_GPDMA, &port->rxDescriptors[1], hw->rxConnection,
+					(uint32_t)(uintptr_t)&port->rxBuffer[OS_UART_RX_HALF_SIZE], OS_UART_RX_HALF_SIZE,
+					GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, &port->rxDescriptors[0]);
+			port->rxDescriptors[0].ctrl |= GPDMA_DMACCxControl_I;
+			port->rxDescriptors[1].ctrl |= GPDMA_DMACCxControl_I;
+			os_uart_rxStart(port);
+
+			/* La interrupción de la UART solo se usa para detectar el fin de
+			 * una ráfaga (CTI), habilitada por os_uart_read, y los errores
+			 * de línea */
+			Chip_UART_IntEnable(hw->uart, UART_IER_RLSINT);
+
+			os_uart_ports[id] = port;
+			os_insertIRQ(hw->irq, hw->irqHandler);
+			result = true;
+		}
+		else
+		{
+			os_dma_freeChannel(port->txChannel);
+			os_dma_freeChannel(port->rxChannel);
+		}
+	}
+
+	return result;
+}
+
+uint32_t os_uart_write(os_Uart_t * port, const void * data, uint32_t length)
+{
+	const os_uart_hw_t * hw = &os_uart_hw[port->id];
+	uint32_t written = 0;
+	uint32_t chunk;
+	bool error = false;
+
+	/* Desde una interrupción no se puede esperar al fin de la transferencia */
+	if (os_control_state__running_from_IRQ == os_get_controlState())
+	{
+		length = 0;
+	}
+
+	while ((written < length) && !error)
+	{
+		chunk = length - written;
+		if (chunk > OS_DMA_MAX_TRANSFER_SIZE)
+		{
+			chunk = OS_DMA_MAX_TRANSFER_SIZE;
+		}
+
+		port->txError = false;
+		port->txBusy = true;
+		Chip_GPDMA_Transfer(LPC_GPDMA, port->txChannel, (uint32_t)(uintptr_t)data + written,
+				hw->txConnection, GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA, chunk);
+
+		while (port->txBusy)
+		{
+			/* Si la transferencia termina antes del bloqueo, la interrupción queda
+			 * pendiente hasta salir de la sección crítica y despierta a la tarea */
+			os_enter_critical_zone();
+			if (port->txBusy)
+			{
+				os_blockActualTaskOn(&port->txWaiting, OS_WAIT_FOREVER);
+			}
+			os_exit_critical_zone();
+
+			os_CpuYield();
+		}
+
+		error = port->txError;
+		if (!error)
+		{
+			written += chunk;
+		}
+	}
+
+	return written;
+}
+
+uint16_t os_uart_read(os_Uart_t * port, void * data, uint16_t maxLength, uint32_t timeout)
+{
+	const os_uart_hw_t * hw = &os_uart_hw[port->id];
+	os_TaskHandler_t* actualTask = NULL;
+	uint32_t written;
+	uint16_t position;
+	uint16_t read = 0;
+	uint16_t firstChunk;
+	bool done = false;
+
+	/* Desde una interrupción nunca se bloquea */
+	if (os_control_state__running_from_IRQ == os_get_controlState())
+	{
+		timeout = OS_NO_WAIT;
+	}
+
+	while (!done)
+	{
+		os_enter_critical_zone();
+		if (port->rxStopped)
+		{
+			os_uart_rxStart(port);
+		}
+
+		read = os_uart_rxAvailable(port);
+		if ((0 < read) || (OS_NO_WAIT == timeout) || port->rxErrorWakeUp)
+		{
+			port->rxErrorWakeUp = false;
+			done = true;
+		}
+		else
+		{
+			/* El timeout de caracter despierta a la lectora al final de una
+			 * ráfaga; el handler lo vuelve a enmascarar */
+			Chip_UART_IntEnable(hw->uart, UART_IER_RBRINT);
+			actualTask = os_blockActualTaskOn(&port->rxWaiting, timeout);
+		}
+		os_exit_critical_zone();
+
+		if (!done)
+		{
+			os_CpuYield();
+			timeout = os_getRemainingTimeout(&port->rxWaiting, actualTask, timeout);
+		}
+	}
+
+	/* Hay un único lector por puerto: la copia no necesita sección crítica */
+	if (read > maxLength)
+	{
+		read = maxLength;
+	}
+
+	firstChunk = OS_UART_RX_BUFFER_SIZE - port->rxTail;
+	if (firstChunk > read)
+	{
+		firstChunk = read;
+	}
+	memcpy(data, &port->rxBuffer[port->rxTail], firstChunk);
+	memcpy((uint8_t *)data + firstChunk, port->rxBuffer, read - firstChunk);
+
+	/* El GPDMA pudo alcanzar los datos mientras se copiaban */
+	if (0 < read)
+	{
+		os_enter_critical_zone();
+		written = os_uart_rxWritten(port, &position);
+		if ((written - port->rxRead) > OS_UART_RX_BUFFER_SIZE)
+		{
+			os_uart_rxDiscard(port, written, position);
+			read = 0;
+		}
+		else
+		{
+			port->rxRead += read;
+			port->rxTail = ((uint32_t)port->rxTail + read) % OS_UART_RX_BUFFER_SIZE;
+		}
+		os_exit_critical_zone();
+	}
+
+	return read;
+}
+
+uint8_t os_uart_getErrors(os_Uart_t * port)
+{
+	uint8_t errors;
+
+	os_enter_critical_zone();
+	errors = port->errors;
+	port->errors = 0;
+	os_exit_critical_zone();
+
+	return errors;
+}
+
+/******************************************************************************
+ * Funciones privadas
+ *****************************************************************************/
+
+/******************************************************************************
+ *  @brief Bytes recibidos y no leídos.
+ *
+ *  @details
+ *   Si el GPDMA ya sobrescribió datos no leídos, el contenido del buffer se
+ *   descarta y se informa el overrun. Debe llamarse dentro de una sección
+ *   crítica.
+ *
+ *  @param *port				puerto
+ *  @return     bytes disponibles.
+******************************************************************************/
+static uint16_t os_uart_rxAvailable(os_Uart_t * port)
+{
+	uint16_t position;
+	uint32_t written = os_uart_rxWritten(port, &position);
+	uint32_t available = written - port->rxRead;
+
+	if (available > OS_UART_RX_BUFFER_SIZE)
+	{
+		os_uart_rxDiscard(port, written, position);
+		port->rxErrorWakeUp = true;
+		available = 0;
+	}
+
+	return (uint16_t)available;
+}
+
+/******************************************************************************
+ *  @brief Bytes escritos por el GPDMA desde que arrancó la recepción.
+ *
+ *  @details
+ *   La posición de escritura es la dirección destino actual del canal de
+ *   recepción. Si está en una mitad distinta de la que indica la cuenta de
+ *   mitades, el GPDMA ya pasó al otro descriptor y su interrupción todavía
+ *   no fue atendida. La cuenta es módulo 2^32, igual que rxRead, por lo que
+ *   la diferencia entre ambas es válida. Debe llamarse dentro de una
+ *   sección crítica.
+ *
+ *  @param *port				puerto
+ *  @param *position			posición de escritura dentro del buffer
+ *  @return     bytes escritos.
+******************************************************************************/
+static uint32_t os_uart_rxWritten(os_Uart_t * port, uint16_t * position)
+{
+	uint32_t halves = port->rxHalves;
+	uint32_t head = LPC_GPDMA->CH[port->rxChannel].DESTADDR - (uint32_t)(uintptr_t)port->rxBuffer;
+
+	head %= OS_UART_RX_BUFFER_SIZE;
+	if ((head / OS_UART_RX_HALF_SIZE) != (halves & 1))
+	{
+		halves++;
+	}
+	*position = (uint16_t)head;
+
+	return (halves * OS_UART_RX_HALF_SIZE) + (head % OS_UART_RX_HALF_SIZE);
+}
+
+/******************************************************************************
+ *  @brief Descarta los datos recibidos luego de un overrun.
+ *
+ *  @param *port				puerto
+ *  @param written				bytes escritos (os_uart_rxWritten)
+ *  @param position				posición de escritura dentro del buffer
+ *  @return     none.
+******************************************************************************/
+static void os_uart_rxDiscard(os_Uart_t * port, uint32_t written, uint16_t position)
+{
+	port->rxRead = written;
+	port->rxTail = position;
+	port->errors |= OS_UART_ERROR_OVERRUN;
+}
+
+/******************************************************************************
+ *  @brief Arranca la recepción continua desde el comienzo del buffer.
+ *
+ *  @details
+ *   Se usa en la inicialización y para reanudar la recepción luego de un
+ *   error del GPDMA, que deshabilita el canal.
+ *
+ *  @param *port				puerto
+ *  @return     none.
+******************************************************************************/
+static void os_uart_rxStart(os_Uart_t * port)
+{
+	port->rxStopped = false;
+	port->rxHalves = 0;
+	port->rxRead = 0;
+	port->rxTail = 0;
+	Chip_GPDMA_SGTransfer(LPC_GPDMA, port->rxChannel, &port->rxDescriptors[0],
+			GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA);
+}
+
+/******************************************************************************
+ *  @brief Registra un error y marca que la lectora debe retornar.
+ *
+ *  @param *port				puerto
+ *  @param error				OS_UART_ERROR_xxx
+ *  @return     none.
+******************************************************************************/
+static void os_uart_setError(os_Uart_t * port, uint8_t error)
+{
+	/* La interrupción del GPDMA y la de la UART pueden anidarse */
+	os_enter_critical_zone();
+	port->errors |= error;
+	port->rxErrorWakeUp = true;
+	os_exit_critical_zone();
+}
+
+/******************************************************************************
+ *  @brief Fin de una transmisión.
+ *
+ *  @param channel				canal del GPDMA
+ *  @param error				true si la transferencia falló
+ *  @param *param				puerto
+ *  @return     none.
+******************************************************************************/
+static void os_uart_txCallback(uint8_t channel, bool error, void * param)
+{
+	os_Uart_t * port = (os_Uart_t *)param;
+
+	if (error)
+	{
+		os_enter_critical_zone();
+		port->errors |= OS_UART_ERROR_DMA;
+		os_exit_critical_zone();
+	}
+	port->txError = error;
+	port->txBusy = false;
+	os_wakeUpWaitingTask(&port->txWaiting);
+}
+
+/******************************************************************************
+ *  @brief Se completó una mitad del buffer de recepción.
+ *
+ *  @details
+ *   Ante un error el GPDMA deshabilita el canal: la recepción se reanuda en
+ *   la próxima lectura.
+ *
+ *  @param channel				canal del GPDMA
+ *  @param error				true si la transferencia falló
+ *  @param *param				puerto
+ *  @return     none.
+******************************************************************************/
+static void os_uart_rxCallback(uint8_t channel, bool error, void * param)
+{
+	os_Uart_t * port = (os_Uart_t *)param;
+
+	if (error)
+	{
+		port->rxStopped = true;
+		os_uart_setError(port, OS_UART_ERROR_DMA);
+	}
+	else
+	{
+		port->rxHalves++;
+	}
+	os_wakeUpWaitingTask(&port->rxWaiting);
+}
+
+/******************************************************************************
+ *  @brief Handler de la interrupción de una UART.
+ *
+ *  @details
+ *   En modo DMA el GPDMA vacía el FIFO de recepción. La interrupción de
+ *   timeout de caracter indica que la línea quedó inactiva luego de una
+ *   ráfaga, por lo que se despierta al lector para que no espere a que
+ *   se complete la mitad del buffer. Como el GPDMA vacía el FIFO, esa
+ *   interrupción (y la de nivel del FIFO, RDA) podría repetirse: se
+ *   enmascara hasta que la lectora vuelva a esperar.
+ *
+ *  @param id					UART que interrumpió
+ *  @return     none.
+******************************************************************************/
+static void os_uart_IRQHandler(os_uart_id_t id)
+{
+	const os_uart_hw_t * hw = &os_uart_hw[id];
+	os_Uart_t * port = os_uart_ports[id];
+	uint32_t interruptId = Chip_UART_ReadIntIDReg(hw->uart) & UART_IIR_INTID_MASK;
+
+	if (UART_IIR_INTID_RLS == interruptId)
+	{
+		/* Leer el registro de estado limpia los errores de línea */
+		if (Chip_UART_ReadLineStatus(hw->uart) &
+				(UART_LSR_OE | UART_LSR_PE | UART_LSR_FE | UART_LSR_BI))
+		{
+			os_uart_setError(port, OS_UART_ERROR_LINE);
+			os_wakeUpWaitingTask(&port->rxWaiting);
+		}
+	}
+	else if ((UART_IIR_INTID_CTI == interruptId) ||
+			(UART_IIR_INTID_RDA == interruptId))
+	{
+		Chip_UART_IntDisable(hw->uart, UART_IER_RBRINT);
+		os_wakeUpWaitingTask(&port->rxWaiting);
+	}
+}
+
+static void os_uart0_IRQHandler(void){os_uart_IRQHandler(os_uart_0);}
+static void os_uart1_IRQHandler(void){os_uart_IRQHandler(os_uart_1);}
+static void os_uart2_IRQHandler(void){os_uart_IRQHandler(os_uart_2);}
+static void os_uart3_IRQHandler(void){os_uart_IRQHandler(os_uart_3);}
@@ -6,6 +6,11 @@
 #include "MSE_OS_Core.h"
 #include "MSE_OS_API.h"
 #include "MSE_OS_IRQ.h"
+#include "MSE_OS_Log.h"
+#include "MSE_OS_Uart.h"
+#include "MSE_OS_PubSub.h"
+#include "MSE_OS_Timer.h"
+#include "MSE_OS_Shell.h"
 
 #include <string.h>
 
@@ -20,7 +25,8 @@
 #define TEC2_BIT_VAL    8
 
 #define MAX_STRING_MESSAGE	256
-#define MAX_STRING_LENGTH_FOR_NUMBER_VALUE	20
+
+#define LOG_DRAIN_PERIOD_MS	20
 
 #define PRIORIDAD_MAXIMA		0
 #define PRIORIDAD_ALTA			1
@@ -29,11 +35,17 @@
 
 /*==================[Global data declaration]==============================*/
 
-os_TaskHandler_t handler_tareaControl;
-os_TaskHandler_t handler_tareaLed;
-os_TaskHandler_t handler_tareaNotificacionUart;
+os_TaskHandler_t *handler_tareaControl;
+os_TaskHandler_t *handler_tareaLed;
+os_TaskHandler_t *handler_tareaNotificacionUart;
+os_TaskHandler_t *handler_tareaLog;
+
+os_Queue_t		queueEvents;
+
+os_Topic_t		topicResultado;
+os_Subscriber_t	subscriberLed, subscriberUart;
 
-os_Queue_t		queueEvents, queueLed, queueUart;
+os_Uart_t		uartUsb;
 
 /*==================[internal functions declaration]=========================*/
 
@@ -70,18 +82,38 @@ typedef enum
 	led_azul
 } led_id_t;
 
-typedef struct
-{
-	led_id_t led;
-	uint32_t time;
-} ledQueueElement_t;
-
+/* Resultado de una secuencia, publicado en topicResultado. Los tiempos se
+ * expresan en microsegundos */
 typedef struct
 {
 	led_id_t led;
 	uint32_t t1;
 	uint32_t t2;
-} uartQueueElement_t;
+} resultado_t;
+
+/* Strings de formato del log, indexados por log_id_t. Todos los argumentos
+ * se guardan como uint32_t */
+typedef enum
+{
+	log_led_encendido,
+	log_cantidad_formatos
+} log_id_t;
+
+static const char * const logFormats[log_cantidad_formatos] =
+{
+	[log_led_encendido] = "Led %s encendido:\n\r"
+			" \t Tiempo encendido: %u us\n\r"
+			" \t Tiempo entre flancos descendentes: %u us\n\r"
+			" \t Tiempo entre flancos ascendentes: %u us\n\r",
+};
+
+static const char * const ledNames[] =
+{
+	[led_verde] = "Verde",
+	[led_rojo] = "Rojo",
+	[led_amarillo] = "Amarillo",
+	[led_azul] = "Azul",
+};
 
 /*==================[external data definition]===============================*/
 
@@ -135,7 +167,8 @@ static void initHardware(void)  {
 	Chip_PININT_SetPinModeEdge( LPC_GPIO_PIN_INT, PININTCH( 3 ) );
 	Chip_PININT_EnableIntHigh( LPC_GPIO_PIN_INT, PININTCH( 3 ) );
 
-	/* Inicializar UART_USB a 115200 baudios */
+	/* Rutear los pines de UART_USB. La UART la configura luego el driver
+	 * del sistema operativo */
 	uartConfig( UART_USB, 115200 );
 
 }
@@ -149,9 +182,8 @@ static void initHardware(void)  {
  *  @details
  *   Esta tarea contiene la lógica de aplicación. Implementa
  *   una máquina de estados cuyos eventos los recibe a través de la
- *   cola queueEvents y ordena mostrar por los leds y por la UART
- *   información, a través de las colas queueLed y queueUART
- *   respectivamente
+ *   cola queueEvents y publica el resultado de cada secuencia en
+ *   topicResultado, al que están suscriptas las tareas de leds y de UART
  *
  *  @param 	none
  *  @return none
@@ -160,10 +192,10 @@ void controlTask()
 {
 	estados_t estado;
 	eventQueueElement_t mesg;
-	ledQueueElement_t ledMsg;
-	uartQueueElement_t uartMsg;
+	resultado_t * resultado;
+	led_id_t ledId;
 
-	uint32_t t1_start_timestamp,t2_start_timestamp;
+	uint64_t t1_start_timestamp,t2_start_timestamp;
 	uint32_t t1, t2;
 
 	bool firstTec1Down, firstTec1Up, finDeSecuencia;
@@ -184,20 +216,20 @@ void controlTask()
 				{
 					firstTec1Down = true;
 					estado = wait_tecla2_down;
-					t1_start_timestamp = os_get_systemClockMs();
+					t1_start_timestamp = os_get_systemClockUs();
 				}
 				else if (tecla2_down == mesg.evento)
 				{
 					firstTec1Down = false;
 					estado = wait_tecla1_down;
-					t1_start_timestamp = os_get_systemClockMs();
+					t1_start_timestamp = os_get_systemClockUs();
 				}
 				break;
 			case wait_tecla1_down:
 				if (tecla1_down == mesg.evento)
 				{
 					estado = wait_tecla1_up_o_tecla2_up;
-					t1 = os_get_systemClockMs() - t1_start_timestamp;
+					t1 = (uint32_t)(os_get_systemClockUs() - t1_start_timestamp);
 				}
 				else if (tecla2_up == mesg.evento)
 				{
@@ -209,7 +241,7 @@ void controlTask()
 				if (tecla2_down == mesg.evento)
 				{
 					estado = wait_tecla1_up_o_tecla2_up;
-					t1 = os_get_systemClockMs() - t1_start_timestamp;
+					t1 = (uint32_t)(os_get_systemClockUs() - t1_start_timestamp);
 				}
 				else if (tecla1_up == mesg.evento)
 				{
@@ -222,20 +254,20 @@ void controlTask()
 				{
 					firstTec1Up = true;
 					estado = wait_tecla2_up;
-					t2_start_timestamp = os_get_systemClockMs();
+					t2_start_timestamp = os_get_systemClockUs();
 				}
 				else if (tecla2_up == mesg.evento)
 				{
 					firstTec1Up = false;
 					estado = wait_tecla1_up;
-					t2_start_timestamp = os_get_systemClockMs();
+					t2_start_timestamp = os_get_systemClockUs();
 				}
 				break;
 			case wait_tecla1_up:
 				if (tecla1_up == mesg.evento)
 				{
 					estado = wait_tecla1_down_o_tecla2_down;
-					t2 = os_get_systemClockMs() - t2_start_timestamp;
+					t2 = (uint32_t)(os_get_systemClockUs() - t2_start_timestamp);
 					finDeSecuencia  = true;
 					/* */
 				}
@@ -249,7 +281,7 @@ void controlTask()
 				if (tecla2_up == mesg.evento)
 				{
 					estado = wait_tecla1_down_o_tecla2_down;
-					t2 = os_get_systemClockMs() - t2_start_timestamp;
+					t2 = (uint32_t)(os_get_systemClockUs() - t2_start_timestamp);
 					finDeSecuencia  = true;
 					/* */
 				}
@@ -273,31 +305,35 @@ void controlTask()
 			{
 				if (firstTec1Up)
 				{
-					ledMsg.led = led_verde;
+					ledId = led_verde;
 				}
 				else
 				{
-					ledMsg.led = led_rojo;
+					ledId = led_rojo;
 				}
 			}
 			else
 			{
 				if (firstTec1Up)
 				{
-					ledMsg.led = led_amarillo;
+					ledId = led_amarillo;
 				}
 				else
 				{
-					ledMsg.led = led_azul;
+					ledId = led_azul;
 				}
 			}
-			ledMsg.time = t1 + t2;
-			os_queue_insert(&queueLed, &ledMsg);
-			uartMsg.led = ledMsg.led;
-			uartMsg.t1 = t1;
-			uartMsg.t2 = t2;
-			os_queue_insert(&queueUart, &uartMsg);
 
+			/* Un único mensaje que comparten todos los suscriptores. Si el pool
+			 * está agotado el resultado se pierde */
+			resultado = os_pubsub_alloc();
+			if (NULL != resultado)
+			{
+				resultado->led = ledId;
+				resultado->t1 = t1;
+				resultado->t2 = t2;
+				os_pubsub_publish(&topicResultado, resultado);
+			}
 		}
 	}
 }
@@ -307,8 +343,8 @@ void controlTask()
  *
  *  @details
  *   Esta tarea se ocupa de mostrar en los leds la información recibida
- *   desde queueLed (básicamente que led debe encenderse y durantecuanto
- *   tiempo)
+ *   desde topicResultado (básicamente que led debe encenderse y durante
+ *   cuanto tiempo)
  *
  *  @param 	none
  *  @return none
@@ -316,19 +352,26 @@ void controlTask()
 void ledsControlTask()
 {
 	gpioMap_t led;
-	ledQueueElement_t msg;
+	const resultado_t * msg;
+	uint32_t time;
+
 	while(1)
 	{
-		os_queue_remove(&queueLed, &msg);
-		switch (msg.led)
+		msg = os_pubsub_receive(&subscriberLed);
+		switch (msg->led)
 		{
 			case led_verde: led = LEDG; break;
 			case led_rojo: led = LEDR; break;
 			case led_amarillo: led = LED2; break;
 			case led_azul: led = LEDB; break;
 		}
+		time = msg->t1 + msg->t2;
+
+		/* El mensaje se libera antes de la espera para devolverlo al pool cuanto antes */
+		os_pubsub_release(msg);
+
 		gpioWrite(led, true);
-		os_Delay(msg.time);
+		os_timer_sleepUs(time);
 		gpioWrite(led, false);
 	}
 }
@@ -337,50 +380,51 @@ void ledsControlTask()
  *  @brief Tarea de notifiación por UART
  *
  *  @details
- *   Esta tarea se ocupa de enviar por la UART un mensaje acerca de que led
- *   se enciende, y los valores de t1 y t2. La información la recibe desde
- *   la cola queueUART
+ *   Esta tarea registra en el log qué led se enciende, y los valores de t1
+ *   y t2. La información la recibe desde topicResultado. El mensaje no
+ *   se formatea aquí sino en logDrainTask
  *
  *  @param 	none
  *  @return none
  *****************************************************************************/
 void uartNotificationTask()
+{
+	const resultado_t * msg;
+
+	while(1)
+	{
+		msg = os_pubsub_receive(&subscriberUart);
+		OS_LOG4(log_led_encendido, ledNames[msg->led], msg->t1 + msg->t2, msg->t1, msg->t2);
+		os_pubsub_release(msg);
+	}
+}
+
+/******************************************************************************
+ *  @brief Tarea de vaciado del log
+ *
+ *  @details
+ *   Formatea los registros del log y los envía por la UART mediante DMA,
+ *   sin ocupar el CPU mientras se transmiten. Al ser la tarea
+ *   de menor prioridad, el costo de formatear y transmitir no afecta a las
+ *   tareas que registran los eventos. También atiende la consola de diagnóstico,
+ *   que comparte la misma UART
+ *
+ *  @param 	none
+ *  @return none
+ *****************************************************************************/
+void logDrainTask()
 {
 	static char message[MAX_STRING_MESSAGE];
-	static char number[MAX_STRING_LENGTH_FOR_NUMBER_VALUE];
-	uartQueueElement_t msg;
-	message[0] = 0;
+	uint32_t lastWake = os_get_systemClockMs();
 
 	while(1)
 	{
-		os_queue_remove(&queueUart, &msg);
-		message[0] = 0;
-		strcat(&message, "Led ");
-		switch (msg.led)
+		while (os_log_format(message, sizeof(message)))
 		{
-			case led_verde: strcat(&message, "Verde"); break;
-			case led_rojo: strcat(&message, "Rojo"); break;
-			case led_amarillo: strcat(&message, "Amarillo"); break;
-			case led_azul: strcat(&message, "Azul"); break;
+			os_uart_write(&uartUsb, message, strlen(message));
 		}
-		strcat(&message, " encendido:​ \n\r");
-
-		strcat(&message, " \t ​ Tiempo encendido: ​");
-		itoa(msg.t1+msg.t2,number,10);
-		strcat(&message, number);
-		strcat(&message, " ms​ \n\r");
-
-		strcat(&message, " \t ​ Tiempo entre flancos descendentes: ​");
-		itoa(msg.t1,number,10);
-		strcat(&message, number);
-		strcat(&message, " ms​ \n\r");
-
-		strcat(&message, " \t ​ Tiempo entre flancos ascendentes:: ​");
-		itoa(msg.t2,number,10);
-		strcat(&message, number);
-		strcat(&message, " ms​ \n\r");
-
-		uartWriteString(UART_USB, message);
+		os_shell_poll();
+		os_DelayUntil(&lastWake, LOG_DRAIN_PERIOD_MS);
 	}
 }
 
@@ -464,12 +508,23 @@ int main(void)  {
 	initHardware();
 
 	os_queue_init(&queueEvents, sizeof(eventQueueElement_t));
-	os_queue_init(&queueLed, sizeof(ledQueueElement_t));
-	os_queue_init(&queueUart, sizeof(uartQueueElement_t));
 
-	os_InitTask(&handler_tareaControl, controlTask, PRIORIDAD_ALTA);
-	os_InitTask(&handler_tareaLed, ledsControlTask, PRIORIDAD_MAXIMA);
-	os_InitTask(&handler_tareaNotificacionUart, uartNotificationTask, PRIORIDAD_MEDIA);
+	/* Los leds frenan al publicador si se atrasan; las notificaciones por UART
+	 * se descartan */
+	os_pubsub_init();
+	os_topic_init(&topicResultado);
+	os_pubsub_subscribe(&topicResultado, &subscriberLed, os_pubsub_policy__block);
+	os_pubsub_subscribe(&topicResultado, &subscriberUart, os_pubsub_policy__drop);
+
+	os_log_init(logFormats, log_cantidad_formatos);
+	os_uart_init(&uartUsb, os_uart_2, 115200);
+	os_timer_init();
+	os_shell_init(&uartUsb);
+
+	handler_tareaControl = os_InitTask(controlTask, PRIORIDAD_ALTA);
+	handler_tareaLed = os_InitTask(ledsControlTask, PRIORIDAD_MAXIMA);
+	handler_tareaNotificacionUart = os_InitTask(uartNotificationTask, PRIORIDAD_MEDIA);
+	handler_tareaLog = os_InitTask(logDrainTask, PRIORIDAD_BAJA);
 
 	os_insertIRQ(PIN_INT0_IRQn, tecla1_down_ISR);
 	os_insertIRQ(PIN_INT1_IRQn,tecla1_up_ISR);
@@ -0,0 +1,167 @@
+/*
+ * board.h (host)
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Sustituto de board.h para compilar en el host los módulos que
+ *         se prueban fuera de la placa. Los periféricos son estructuras en
+ *         RAM y las funciones Chip_xxx las implementa cada prueba.
+ */
+
+#ifndef TEST_STUBS_BOARD_H_
+#define TEST_STUBS_BOARD_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cmsis_43xx.h"
+
+#define __DMB()		__atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/*==================[SIMD del Cortex-M4]=====================================*/
+static inline int32_t test_sat(int32_t value, uint32_t bits)
+{
+	const int32_t max = (1 << (bits - 1)) - 1;
+	return (value > max) ? max : ((value < -max - 1) ? -max - 1 : value);
+}
+
+static inline uint32_t test_pack(int32_t low, int32_t high)
+{
+	return ((uint32_t)(uint16_t)low) | ((uint32_t)(uint16_t)high << 16);
+}
+
+#define TEST_LO(x)		((int32_t)(int16_t)(x))
+#define TEST_HI(x)		((int32_t)(int16_t)((x) >> 16))
+
+#define __SSAT(x, bits)		test_sat((x), (bits))
+
+static inline uint32_t __QADD16(uint32_t a, uint32_t b)
+{
+	return test_pack(test_sat(TEST_LO(a) + TEST_LO(b), 16), test_sat(TEST_HI(a) + TEST_HI(b), 16));
+}
+
+static inline uint32_t __SHADD16(uint32_t a, uint32_t b)
+{
+	return test_pack((TEST_LO(a) + TEST_LO(b)) >> 1, (TEST_HI(a) + TEST_HI(b)) >> 1);
+}
+
+static inline uint32_t __PKHBT(uint32_t a, uint32_t b, uint32_t shift)
+{
+	return (a & 0xFFFF) | ((b << shift) & 0xFFFF0000);
+}
+
+static inline uint32_t __PKHTB(uint32_t a, uint32_t b, uint32_t shift)
+{
+	return (a & 0xFFFF0000) | ((uint32_t)((int32_t)b >> shift) & 0xFFFF);
+}
+
+static inline uint64_t __SMLALD(uint32_t a, uint32_t b, uint64_t acc)
+{
+	return (uint64_t)((int64_t)acc + (int64_t)TEST_LO(a) * TEST_LO(b) +
+			(int64_t)TEST_HI(a) * TEST_HI(b));
+}
+
+/*==================[GPDMA]==================================================*/
+typedef enum {ERROR = 0, SUCCESS = !ERROR} Status;
+
+typedef struct
+{
+	volatile uint32_t SRCADDR;
+	volatile uint32_t DESTADDR;
+	volatile uint32_t LLI;
+	volatile uint32_t CONTROL;
+	volatile uint32_t CONFIG;
+} GPDMA_CH_T;
+
+typedef struct
+{
+	volatile uint32_t INTSTAT;
+	volatile uint32_t INTTCSTAT;
+	volatile uint32_t INTTCCLEAR;
+	volatile uint32_t INTERRSTAT;
+	volatile uint32_t INTERRCLR;
+	GPDMA_CH_T CH[8];
+} LPC_GPDMA_T;
+
+typedef struct
+{
+	uint32_t src;
+	uint32_t dst;
+	uint32_t lli;
+	uint32_t ctrl;
+} DMA_TransferDescriptor_t;
+
+typedef enum
+{
+	GPDMA_TRANSFERTYPE_M2M_CONTROLLER_DMA,
+	GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA,
+	GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA
+} GPDMA_FLOW_CONTROL_T;
+
+#define GPDMA_DMACCxControl_I	(1UL << 31)
+#define GPDMA_CONN_UART0_Tx		1
+#define GPDMA_CONN_UART0_Rx		2
+#define GPDMA_CONN_UART1_Tx		3
+#define GPDMA_CONN_UART1_Rx		4
+#define GPDMA_CONN_UART2_Tx		5
+#define GPDMA_CONN_UART2_Rx		6
+#define GPDMA_CONN_UART3_Tx		7
+#define GPDMA_CONN_UART3_Rx		8
+
+extern LPC_GPDMA_T test_gpdma;
+#define LPC_GPDMA	(&test_gpdma)
+
+void Chip_GPDMA_Init(LPC_GPDMA_T * pGPDMA);
+void Chip_GPDMA_Stop(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum);
+Status Chip_GPDMA_Transfer(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum, uint32_t src,
+		uint32_t dst, GPDMA_FLOW_CONTROL_T TransferType, uint32_t Size);
+Status Chip_GPDMA_InitDescriptor(LPC_GPDMA_T * pGPDMA, DMA_TransferDescriptor_t * DMADescriptor,
+		uint32_t src, uint32_t dst, uint32_t Size, GPDMA_FLOW_CONTROL_T TransferType,
+		const DMA_TransferDescriptor_t * NextDescriptor);
+Status Chip_GPDMA_SGTransfer(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum,
+		const DMA_TransferDescriptor_t * DMADescriptor, GPDMA_FLOW_CONTROL_T TransferType);
+
+/*==================[UART]===================================================*/
+typedef struct
+{
+	volatile uint32_t IER;
+	volatile uint32_t IIR;
+	volatile uint32_t LSR;
+} LPC_USART_T;
+
+extern LPC_USART_T test_uart[4];
+#define LPC_USART0	(&test_uart[0])
+#define LPC_UART1	(&test_uart[1])
+#define LPC_USART2	(&test_uart[2])
+#define LPC_USART3	(&test_uart[3])
+
+#define UART_LCR_WLEN8			(3 << 0)
+#define UART_LCR_SBS_1BIT		(0 << 2)
+#define UART_LCR_PARITY_DIS		(0 << 3)
+#define UART_FCR_FIFO_EN		(1 << 0)
+#define UART_FCR_RX_RS			(1 << 1)
+#define UART_FCR_TX_RS			(1 << 2)
+#define UART_FCR_DMAMODE_SEL	(1 << 3)
+#define UART_FCR_TRG_LEV2		(2 << 6)
+#define UART_IER_RBRINT			(1 << 0)
+#define UART_IER_RLSINT			(1 << 2)
+#define UART_IIR_INTID_MASK		(7 << 1)
+#define UART_IIR_INTID_RLS		(3 << 1)
+#define UART_IIR_INTID_RDA		(2 << 1)
+#define UART_IIR_INTID_CTI		(6 << 1)
+#define UART_LSR_OE				(1 << 1)
+#define UART_LSR_PE				(1 << 2)
+#define UART_LSR_FE				(1 << 3)
+#define UART_LSR_BI				(1 << 4)
+
+void Chip_UART_Init(LPC_USART_T * pUART);
+uint32_t Chip_UART_SetBaud(LPC_USART_T * pUART, uint32_t baudrate);
+void Chip_UART_ConfigData(LPC_USART_T * pUART, uint32_t config);
+void Chip_UART_SetupFIFOS(LPC_USART_T * pUART, uint32_t fcr);
+void Chip_UART_TXEnable(LPC_USART_T * pUART);
+void Chip_UART_IntEnable(LPC_USART_T * pUART, uint32_t intMask);
+void Chip_UART_IntDisable(LPC_USART_T * pUART, uint32_t intMask);
+uint32_t Chip_UART_ReadIntIDReg(LPC_USART_T * pUART);
+uint32_t Chip_UART_ReadLineStatus(LPC_USART_T * pUART);
+
+#endif /* TEST_STUBS_BOARD_H_ */
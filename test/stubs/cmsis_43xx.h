@@ -0,0 +1,23 @@
+/*
+ * cmsis_43xx.h (host)
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Interrupciones del LPC43xx usadas por los módulos que se prueban
+ *         en el host
+ */
+
+#ifndef TEST_STUBS_CMSIS_43XX_H_
+#define TEST_STUBS_CMSIS_43XX_H_
+
+typedef enum
+{
+	DMA_IRQn		= 2,
+	USART0_IRQn		= 24,
+	UART1_IRQn		= 25,
+	USART2_IRQn		= 26,
+	USART3_IRQn		= 27,
+} LPC43XX_IRQn_Type;
+
+#endif /* TEST_STUBS_CMSIS_43XX_H_ */
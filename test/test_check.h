@@ -0,0 +1,66 @@
+/*
+ * test_check.h
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Verificaciones comunes a las pruebas en el host. Cada prueba es
+ *         un único archivo que incluye este header.
+ */
+
+#ifndef TEST_TEST_CHECK_H_
+#define TEST_TEST_CHECK_H_
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*==================[macros and definitions]=================================*/
+#define CHECK(cond)		test_check((cond), #cond, __FILE__, __LINE__)
+
+/*==================[Private data declaration]==============================*/
+
+static uint32_t failures;
+
+/*==================[test helpers]===========================================*/
+
+/******************************************************************************
+ *  @brief Registra una verificación fallida.
+ *
+ *  @param cond					resultado de la verificación
+ *  @param *text				condición verificada
+ *  @param *file				archivo de la prueba
+ *  @param line					línea de la verificación
+ *  @return     none.
+******************************************************************************/
+static void test_check(bool cond, const char * text, const char * file, int line)
+{
+	if (!cond)
+	{
+		printf("%s:%d: falló %s\n", file, line, text);
+		failures++;
+	}
+}
+
+/******************************************************************************
+ *  @brief Informa el resultado de la prueba.
+ *
+ *  @param *name				nombre de la prueba
+ *  @return     código de salida del programa (cero si no hubo fallas).
+******************************************************************************/
+static int test_result(const char * name)
+{
+	if (failures)
+	{
+		printf("%s: FAIL (%u errores)\n", name, failures);
+	}
+	else
+	{
+		printf("%s: OK\n", name);
+	}
+
+	return (0 != failures);
+}
+
+#endif /* TEST_TEST_CHECK_H_ */
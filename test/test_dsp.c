@@ -0,0 +1,144 @@
+/*
+ * test_dsp.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Prueba en el host de MSE_OS_DSP.c. Las instrucciones SIMD del
+ *         Cortex-M4 se reemplazan por implementaciones en C (stubs/board.h)
+ *         y el ADC por un bloque de registros de datos como los que deja
+ *         el GPDMA. Los resultados se comparan con cálculos escalares.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <string.h>
+#include "test_check.h"
+#include "MSE_OS_DSP.h"
+
+/*==================[macros and definitions]=================================*/
+#define BLOCK			32
+#define TAPS			6
+
+/* Registro de datos del ADC: valor de 10 bits en los bits 6 a 15 y DONE */
+#define ADC_REG(value)	(((uint32_t)(value) << 6) | (1UL << 31))
+
+/*==================[test helpers]===========================================*/
+
+static int16_t firReference(const int16_t * coeffs, const int16_t * history, uint32_t k)
+{
+	int64_t acc = 0;
+	uint32_t t;
+
+	for (t = 0; t < TAPS; t++)
+	{
+		acc += (int64_t)coeffs[t] * history[k + t];
+	}
+	acc >>= 15;
+
+	return (int16_t)((acc > 32767) ? 32767 : ((acc < -32768) ? -32768 : acc));
+}
+
+/*==================[tests]==================================================*/
+
+int main(void)
+{
+	static const int16_t coeffs[TAPS] = {1000, -2000, 12000, 12000, -2000, 30000};
+	uint32_t raw[BLOCK];
+	int16_t input[2 * BLOCK];
+	int16_t history[TAPS - 1 + 2 * BLOCK];
+	int16_t state[TAPS - 1 + BLOCK];
+	int16_t block[BLOCK];
+	os_dsp_fir_q15_t fir;
+	bool ok;
+	uint32_t n;
+	uint32_t i;
+
+	/* conversión en el lugar */
+	for (i = 0; i < BLOCK; i++)
+	{
+		raw[i] = ADC_REG((i * 33) % 1024);
+	}
+	os_dsp_adcToQ15((int16_t *)raw, raw, BLOCK);
+	ok = true;
+	for (i = 0; i < BLOCK; i++)
+	{
+		int16_t sample;
+
+		memcpy(&sample, (uint8_t *)raw + i * sizeof(int16_t), sizeof(sample));
+		ok = ok && (sample == (int16_t)((((int32_t)(i * 33) % 1024) - 512) * 64));
+	}
+	CHECK(ok);
+
+	/* offset con saturación */
+	for (i = 0; i < BLOCK; i++)
+	{
+		block[i] = (int16_t)(32000 - (int32_t)i * 2000);
+	}
+	os_dsp_offset_q15(block, BLOCK, 1000);
+	ok = true;
+	for (i = 0; i < BLOCK; i++)
+	{
+		int32_t expected = 32000 - (int32_t)i * 2000 + 1000;
+
+		expected = (expected > 32767) ? 32767 : ((expected < -32768) ? -32768 : expected);
+		ok = ok && (block[i] == expected);
+	}
+	CHECK(ok);
+
+	/* decimación por 2 */
+	for (i = 0; i < BLOCK; i++)
+	{
+		block[i] = (int16_t)((int32_t)i * 1000 - 16000 + (i & 1) * 7);
+	}
+	memcpy(input, block, sizeof(block));
+	CHECK((BLOCK / 2) == os_dsp_decimate2_q15(block, BLOCK));
+	ok = true;
+	for (i = 0; i < BLOCK / 2; i++)
+	{
+		ok = ok && (block[i] == ((input[2 * i] + input[2 * i + 1]) >> 1));
+	}
+	CHECK(ok);
+
+	/* cantidad de coeficientes inválida */
+	CHECK(!os_dsp_fir_init_q15(&fir, coeffs, 0, 1, state));
+	CHECK(0 == os_dsp_fir_q15(&fir, block, BLOCK));
+	CHECK(!os_dsp_fir_init_q15(&fir, coeffs, TAPS - 1, 1, state));
+	CHECK(0 == os_dsp_fir_q15(&fir, block, BLOCK));
+
+	/* FIR en dos bloques consecutivos, sin y con decimación */
+	memset(history, 0, sizeof(history));
+	for (i = 0; i < 2 * BLOCK; i++)
+	{
+		input[i] = (int16_t)(((int32_t)(i * 7919) % 65536) - 32768);
+		history[TAPS - 1 + i] = input[i];
+	}
+
+	CHECK(os_dsp_fir_init_q15(&fir, coeffs, TAPS, 1, state));
+	ok = true;
+	for (n = 0; n < 2; n++)
+	{
+		memcpy(block, &input[n * BLOCK], sizeof(block));
+		CHECK(BLOCK == os_dsp_fir_q15(&fir, block, BLOCK));
+		for (i = 0; i < BLOCK; i++)
+		{
+			ok = ok && (block[i] == firReference(coeffs, history, n * BLOCK + i));
+		}
+	}
+	CHECK(ok);
+
+	CHECK(os_dsp_fir_init_q15(&fir, coeffs, TAPS, 4, state));
+	ok = true;
+	for (n = 0; n < 2; n++)
+	{
+		memcpy(block, &input[n * BLOCK], sizeof(block));
+		CHECK((BLOCK / 4) == os_dsp_fir_q15(&fir, block, BLOCK));
+		for (i = 0; i < BLOCK / 4; i++)
+		{
+			ok = ok && (block[i] == firReference(coeffs, history, n * BLOCK + i * 4));
+		}
+	}
+	CHECK(ok);
+
+	return (test_result("test_dsp"));
+}
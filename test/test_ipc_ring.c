@@ -0,0 +1,137 @@
+/*
+ * test_ipc_ring.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Prueba en el host de los rings de MSE_OS_IpcRing.c. Dos hilos
+ *         hacen de M4 y M0APP: el primero envía una secuencia por m4ToM0,
+ *         el segundo la devuelve incrementada por m0ToM4 y ambos verifican
+ *         que no se pierdan ni se reordenen mensajes.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include "MSE_OS_IpcRing.h"
+
+/*==================[macros and definitions]=================================*/
+#define TEST_MESSAGES		100000u
+
+/*==================[Private data declaration]==============================*/
+
+static os_ipcShared_t shared;
+static volatile uint32_t m0Errors;
+
+/******************************************************************************
+ *  @brief Simulación del M0APP: devuelve cada mensaje con param + 1.
+ *
+ *  @return     NULL.
+******************************************************************************/
+static void * m0Thread(void * arg)
+{
+	os_ipcMessage_t msg;
+	uint32_t expected = 0;
+
+	(void)arg;
+
+	while (expected < TEST_MESSAGES)
+	{
+		if (os_ipc_ringGet(&shared.m4ToM0, &msg))
+		{
+			if (msg.id != expected || msg.param != expected * 3u)
+			{
+				m0Errors++;
+			}
+			expected++;
+
+			msg.param++;
+			while (!os_ipc_ringPut(&shared.m0ToM4, &msg))
+			{
+				sched_yield();
+			}
+		}
+		else
+		{
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+int main(void)
+{
+	pthread_t m0;
+	os_ipcMessage_t msg;
+	uint32_t sent = 0;
+	uint32_t received = 0;
+	uint32_t errors = 0;
+	int result = 0;
+
+	os_ipc_ringInit(&shared.m4ToM0);
+	os_ipc_ringInit(&shared.m0ToM4);
+
+	/* ring vacío y lleno */
+	if (os_ipc_ringGet(&shared.m4ToM0, &msg))
+	{
+		errors++;
+	}
+	for (sent = 0; sent < OS_CONFIG_IPC_RING_SIZE; sent++)
+	{
+		msg.id = sent;
+		msg.param = sent * 3u;
+		if (!os_ipc_ringPut(&shared.m4ToM0, &msg))
+		{
+			errors++;
+		}
+	}
+	if (!os_ipc_ringIsFull(&shared.m4ToM0) || os_ipc_ringPut(&shared.m4ToM0, &msg))
+	{
+		errors++;
+	}
+
+	pthread_create(&m0, NULL, m0Thread, NULL);
+
+	while (received < TEST_MESSAGES)
+	{
+		if (sent < TEST_MESSAGES)
+		{
+			msg.id = sent;
+			msg.param = sent * 3u;
+			if (os_ipc_ringPut(&shared.m4ToM0, &msg))
+			{
+				sent++;
+			}
+		}
+
+		if (os_ipc_ringGet(&shared.m0ToM4, &msg))
+		{
+			if (msg.id != received || msg.param != received * 3u + 1u)
+			{
+				errors++;
+			}
+			received++;
+		}
+		else
+		{
+			sched_yield();
+		}
+	}
+
+	pthread_join(m0, NULL);
+
+	errors += m0Errors;
+	if (errors)
+	{
+		printf("test_ipc_ring: FAIL (%u errores)\n", errors);
+		result = 1;
+	}
+	else
+	{
+		printf("test_ipc_ring: OK (%u mensajes)\n", received);
+	}
+
+	return result;
+}
@@ -0,0 +1,315 @@
+/*
+ * test_uart.c
+ *
+ *  Created on: 19 octubre 2026
+ *      Author: Alejandro Permingeat
+ *
+ *  @brief Prueba en el host del driver MSE_OS_Uart.c. El GPDMA, la UART y
+ *         las funciones del kernel que usa el driver se simulan: el canal
+ *         de recepción escribe en el buffer y avanza DESTADDR como lo haría
+ *         el hardware, y las interrupciones se disparan desde la prueba,
+ *         incluso mientras la tarea lectora está bloqueada.
+ */
+
+/*==================[inclusions]=============================================*/
+#include <stdio.h>
+#include <string.h>
+#include "test_check.h"
+#include "MSE_OS_Uart.h"
+#include "MSE_OS_DMA.h"
+#include "MSE_OS_IRQ.h"
+
+/*==================[macros and definitions]=================================*/
+#define HALF		(OS_UART_RX_BUFFER_SIZE / 2)
+
+/*==================[Private data declaration]==============================*/
+
+LPC_GPDMA_T test_gpdma;
+LPC_USART_T test_uart[4];
+
+static os_dma_callback_t dmaCallbacks[OS_DMA_NUMBER_OF_CHANNELS];
+static void * dmaParams[OS_DMA_NUMBER_OF_CHANNELS];
+static void (*uartHandler)(void);
+
+static os_Uart_t port;
+static os_TaskHandler_t fakeTask;
+static uint32_t rxPosition;			/** posición de escritura del canal simulado */
+static uint32_t rxHalvesPending;	/** mitades completadas sin interrupción atendida */
+static uint32_t rxRestarts;
+static uint8_t rxNextByte;
+static uint32_t txPending;
+static bool txFail;
+static void (*onYield)(void);
+
+/*==================[test helpers]===========================================*/
+
+/* El GPDMA recibe n bytes: cada mitad completada deja su interrupción pendiente */
+static void rxBytes(uint32_t n)
+{
+	while (n--)
+	{
+		port.rxBuffer[rxPosition] = rxNextByte++;
+		rxPosition = (rxPosition + 1) % OS_UART_RX_BUFFER_SIZE;
+		if (0 == (rxPosition % HALF))
+		{
+			rxHalvesPending++;
+		}
+	}
+	test_gpdma.CH[port.rxChannel].DESTADDR = (uint32_t)(uintptr_t)&port.rxBuffer[rxPosition];
+}
+
+static void dmaIrq(void)
+{
+	while (rxHalvesPending)
+	{
+		rxHalvesPending--;
+		dmaCallbacks[port.rxChannel](port.rxChannel, false, dmaParams[port.rxChannel]);
+	}
+}
+
+static void uartIrq(uint32_t interruptId, uint32_t lineStatus)
+{
+	test_uart[2].IIR = interruptId;
+	test_uart[2].LSR = lineStatus;
+	uartHandler();
+}
+
+/* Eventos mientras la lectora espera */
+static void yieldBurst(void)
+{
+	CHECK(test_uart[2].IER & UART_IER_RBRINT);
+	rxBytes(5);
+	uartIrq(UART_IIR_INTID_CTI, 0);
+	CHECK(!(test_uart[2].IER & UART_IER_RBRINT));
+}
+
+static void yieldDmaError(void)
+{
+	dmaCallbacks[port.rxChannel](port.rxChannel, true, dmaParams[port.rxChannel]);
+}
+
+static void yieldLineError(void)
+{
+	uartIrq(UART_IIR_INTID_RLS, UART_LSR_FE);
+}
+
+static void yieldTxDone(void)
+{
+	if (txPending)
+	{
+		txPending = 0;
+		dmaCallbacks[port.txChannel](port.txChannel, txFail, dmaParams[port.txChannel]);
+	}
+}
+
+/*==================[peripheral and kernel stand-ins]========================*/
+
+void Chip_GPDMA_Init(LPC_GPDMA_T * pGPDMA) {}
+void Chip_GPDMA_Stop(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum) {}
+
+Status Chip_GPDMA_Transfer(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum, uint32_t src,
+		uint32_t dst, GPDMA_FLOW_CONTROL_T TransferType, uint32_t Size)
+{
+	txPending = Size;
+	return SUCCESS;
+}
+
+Status Chip_GPDMA_InitDescriptor(LPC_GPDMA_T * pGPDMA, DMA_TransferDescriptor_t * DMADescriptor,
+		uint32_t src, uint32_t dst, uint32_t Size, GPDMA_FLOW_CONTROL_T TransferType,
+		const DMA_TransferDescriptor_t * NextDescriptor)
+{
+	DMADescriptor->src = src;
+	DMADescriptor->dst = dst;
+	DMADescriptor->lli = (uint32_t)(uintptr_t)NextDescriptor;
+	DMADescriptor->ctrl = Size;
+	return SUCCESS;
+}
+
+Status Chip_GPDMA_SGTransfer(LPC_GPDMA_T * pGPDMA, uint8_t ChannelNum,
+		const DMA_TransferDescriptor_t * DMADescriptor, GPDMA_FLOW_CONTROL_T TransferType)
+{
+	pGPDMA->CH[ChannelNum].DESTADDR = DMADescriptor->dst;
+	rxPosition = 0;
+	rxHalvesPending = 0;
+	rxRestarts++;
+	return SUCCESS;
+}
+
+void Chip_UART_Init(LPC_USART_T * pUART) {}
+uint32_t Chip_UART_SetBaud(LPC_USART_T * pUART, uint32_t baudrate) { return baudrate; }
+void Chip_UART_ConfigData(LPC_USART_T * pUART, uint32_t config) {}
+void Chip_UART_SetupFIFOS(LPC_USART_T * pUART, uint32_t fcr) {}
+void Chip_UART_TXEnable(LPC_USART_T * pUART) {}
+void Chip_UART_IntEnable(LPC_USART_T * pUART, uint32_t intMask) { pUART->IER |= intMask; }
+void Chip_UART_IntDisable(LPC_USART_T * pUART, uint32_t intMask) { pUART->IER &= ~intMask; }
+uint32_t Chip_UART_ReadIntIDReg(LPC_USART_T * pUART) { return pUART->IIR; }
+uint32_t Chip_UART_ReadLineStatus(LPC_USART_T * pUART) { return pUART->LSR; }
+
+void os_dma_init(void) {}
+
+uint8_t os_dma_allocChannel(os_dma_callback_t callback, void * param)
+{
+	uint8_t channel = 0;
+
+	while (NULL != dmaCallbacks[channel])
+	{
+		channel++;
+	}
+	dmaCallbacks[channel] = callback;
+	dmaParams[channel] = param;
+
+	return channel;
+}
+
+void os_dma_freeChannel(uint8_t channel) {}
+
+bool os_insertIRQ(LPC43XX_IRQn_Type irq, void* isr_user_handler)
+{
+	uartHandler = (void (*)(void))isr_user_handler;
+	return true;
+}
+
+void os_enter_critical_zone() {}
+void os_exit_critical_zone() {}
+os_control_state_t os_get_controlState() { return os_control_state__os_running; }
+
+os_TaskHandler_t* os_blockActualTaskOn(os_TaskHandler_t ** waitSlot, uint32_t timeout)
+{
+	*waitSlot = &fakeTask;
+	return &fakeTask;
+}
+
+void os_wakeUpWaitingTask(os_TaskHandler_t ** waitingTask)
+{
+	*waitingTask = NULL;
+}
+
+void os_CpuYield(void)
+{
+	if (NULL != onYield)
+	{
+		onYield();
+	}
+}
+
+uint32_t os_getRemainingTimeout(os_TaskHandler_t ** waitingTask,
+		os_TaskHandler_t * task, uint32_t timeout)
+{
+	/* Si nadie despertó a la tarea, el timeout expiró */
+	if (task == *waitingTask)
+	{
+		*waitingTask = NULL;
+		timeout = OS_NO_WAIT;
+	}
+	return timeout;
+}
+
+/*==================[tests]==================================================*/
+
+static bool checkSequence(const uint8_t * data, uint16_t length, uint8_t first)
+{
+	uint16_t i;
+	bool result = true;
+
+	for (i = 0; i < length; i++)
+	{
+		result = result && (data[i] == (uint8_t)(first + i));
+	}
+
+	return result;
+}
+
+int main(void)
+{
+	uint8_t data[OS_UART_RX_BUFFER_SIZE];
+	uint8_t first;
+	uint16_t length;
+
+	CHECK(os_uart_init(&port, os_uart_2, 115200));
+	CHECK(test_uart[2].IER & UART_IER_RLSINT);
+	CHECK(!(test_uart[2].IER & UART_IER_RBRINT));
+	CHECK(1 == rxRestarts);
+
+	/* lectura simple */
+	rxBytes(10);
+	CHECK(10 == os_uart_read(&port, data, sizeof(data), OS_NO_WAIT));
+	CHECK(checkSequence(data, 10, 0));
+	CHECK(0 == os_uart_read(&port, data, sizeof(data), OS_NO_WAIT));
+
+	/* el GPDMA pasa a la otra mitad antes de que se atienda su interrupción */
+	first = rxNextByte;
+	rxBytes(HALF);
+	CHECK(1 == rxHalvesPending);
+	CHECK(HALF == os_uart_read(&port, data, sizeof(data), OS_NO_WAIT));
+	CHECK(checkSequence(data, HALF, first));
+	dmaIrq();
+
+	/* vuelta completa del buffer, leída en dos partes */
+	first = rxNextByte;
+	rxBytes(OS_UART_RX_BUFFER_SIZE - 20);
+	dmaIrq();
+	length = os_uart_read(&port, data, 30, OS_NO_WAIT);
+	CHECK(30 == length);
+	length += os_uart_read(&port, &data[30], sizeof(data) - 30, OS_NO_WAIT);
+	CHECK((OS_UART_RX_BUFFER_SIZE - 20) == length);
+	CHECK(checkSequence(data, length, first));
+	CHECK(0 == os_uart_getErrors(&port));
+
+	/* lectura bloqueante despertada por el timeout de caracter */
+	first = rxNextByte;
+	onYield = yieldBurst;
+	CHECK(5 == os_uart_read(&port, data, sizeof(data), OS_WAIT_FOREVER));
+	CHECK(checkSequence(data, 5, first));
+	CHECK(!(test_uart[2].IER & UART_IER_RBRINT));
+	onYield = NULL;
+
+	/* overrun: se descartan los datos y se informa */
+	rxBytes(OS_UART_RX_BUFFER_SIZE + 3);
+	dmaIrq();
+	CHECK(0 == os_uart_read(&port, data, sizeof(data), OS_NO_WAIT));
+	CHECK(OS_UART_ERROR_OVERRUN == os_uart_getErrors(&port));
+	CHECK(0 == os_uart_getErrors(&port));
+	first = rxNextByte;
+	rxBytes(4);
+	CHECK(4 == os_uart_read(&port, data, sizeof(data), OS_NO_WAIT));
+	CHECK(checkSequence(data, 4, first));
+
+	/* overrun con la interrupción de la última mitad sin atender (un atraso
+	 * de más de una mitad no puede distinguirse de una vuelta menos) */
+	rxBytes(OS_UART_RX_BUFFER_SIZE);
+	dmaIrq();
+	rxBytes(HALF + 1);
+	CHECK(1 == rxHalvesPending);
+	CHECK(0 == os_uart_read(&port, data, sizeof(data), OS_NO_WAIT));
+	CHECK(OS_UART_ERROR_OVERRUN == os_uart_getErrors(&port));
+	dmaIrq();
+
+	/* error del GPDMA: la lectora retorna y la recepción se reanuda */
+	onYield = yieldDmaError;
+	CHECK(0 == os_uart_read(&port, data, sizeof(data), OS_WAIT_FOREVER));
+	CHECK(OS_UART_ERROR_DMA == os_uart_getErrors(&port));
+	onYield = NULL;
+	CHECK(0 == os_uart_read(&port, data, sizeof(data), OS_NO_WAIT));
+	CHECK(2 == rxRestarts);
+	first = rxNextByte;
+	rxBytes(3);
+	CHECK(3 == os_uart_read(&port, data, sizeof(data), OS_NO_WAIT));
+	CHECK(checkSequence(data, 3, first));
+
+	/* error de línea */
+	onYield = yieldLineError;
+	CHECK(0 == os_uart_read(&port, data, sizeof(data), OS_WAIT_FOREVER));
+	CHECK(OS_UART_ERROR_LINE == os_uart_getErrors(&port));
+	onYield = NULL;
+
+	/* transmisión, con y sin error del GPDMA */
+	onYield = yieldTxDone;
+	CHECK(5 == os_uart_write(&port, "hola\n", 5));
+	CHECK(0 == os_uart_getErrors(&port));
+	txFail = true;
+	CHECK(0 == os_uart_write(&port, "hola\n", 5));
+	CHECK(OS_UART_ERROR_DMA == os_uart_getErrors(&port));
+	onYield = NULL;
+
+	return (test_result("test_uart"));
+}